@@ -0,0 +1,45 @@
+#!/bin/bash
+if [ ! "$BASH_VERSION" ] ; then
+	echo "Please use BASH to run this script ($0)" 1>&2
+	exit 1
+fi
+osstring=`uname`
+
+if [ "$osstring" = "Darwin" ]; then
+	libname="libdiffrec.dylib"
+	sharedflag="-dynamiclib"
+elif [ "$osstring" = "Linux" ]; then
+	libname="libdiffrec.so"
+	sharedflag="-shared"
+else
+	echo "Operating System not recognized"
+	echo "Only MacOSX and Linux supported"
+	echo "Exiting script"
+	exit 1
+fi
+
+# Use the compiler from the environment if one is set.
+if [ -z "$CC" ]; then
+	CC="cc"
+fi
+
+echo "Running config_src Script:"
+
+# Directory containing this script, so it may be run from anywhere.
+MY_DIRECTORY=$(cd "$(dirname "$0")" && pwd)
+SRC_DIRECTORY="$MY_DIRECTORY/rss_ringoccs/diffrec/src"
+OUT_DIRECTORY="$MY_DIRECTORY/rss_ringoccs/diffrec"
+
+# -std=c99 disables floating point contraction so results match NumPy.
+CFLAGS="-std=c99 -O3 -fPIC -pthread -Wall -Wextra -pedantic"
+
+echo -e ' \t ' "Compiling the diffraction reconstruction engine..."
+$CC $CFLAGS $sharedflag "$SRC_DIRECTORY"/*.c -o "$OUT_DIRECTORY/$libname" -lm -lpthread
+
+if [ $? -ne 0 ]; then
+	echo -e ' \t ' "Compilation failed."
+	echo -e ' \t ' "rss_ringoccs will use the pure Python reconstruction."
+	exit 1
+fi
+
+echo -e ' \t ' "Built $OUT_DIRECTORY/$libname"
@@ -0,0 +1,94 @@
+"""
+decimate_benchmark.py
+
+Purpose:
+    Compare the two filters RSRReader can use to decimate 16 kHz data to
+    1 kHz: 'scipy' (scipy.signal.decimate with zero_phase=True, applied
+    twice with a factor of 4) and 'polyphase' (a single-pass polyphase FIR
+    in complex64). Passband error is measured with complex tones, and
+    throughput with a long synthetic signal of 16-bit I and Q, so no RSR
+    file is needed.
+
+Notes:
+    #. Passband error is the largest deviation from the ideal 1 kHz tone,
+        relative to its amplitude, away from the ends of the signal.
+    #. The 'scipy' timing includes converting the signal to complex128,
+        which is what RSRReader does before decimating.
+"""
+import sys
+import time
+import numpy as np
+from scipy.signal import decimate
+
+sys.path.append('../')
+from rss_ringoccs.rsr_reader.polyphase import PolyphaseDecimator
+sys.path.remove('../')
+
+# ***** Begin user input *****
+fs_hz = 16000.0                 # Input sample rate
+q = 16                          # Decimation factor
+tone_freqs_hz = np.linspace(0.0, 400.0, 41)    # Passband test tones
+tone_sec = 20.0                 # Length of each tone test
+bench_sec = 600.0               # Length of the throughput test signal
+chunk_pts = 512000              # Samples per block for the streaming test
+# ***** End user input *****
+
+
+def scipy_path(IQ):
+    IQ = IQ.astype(complex)
+    IQ = decimate(IQ, 4, zero_phase=True)
+    return decimate(IQ, 4, zero_phase=True)
+
+
+def polyphase_path(IQ):
+    return PolyphaseDecimator(q).decimate(IQ).astype(complex)
+
+
+def polyphase_stream_path(IQ):
+    dec = PolyphaseDecimator(q)
+    out = [dec.process(IQ[i:i + chunk_pts])
+            for i in range(0, len(IQ), chunk_pts)]
+    out.append(dec.flush())
+    return np.hstack(out).astype(complex)
+
+
+def passband_error(func):
+    n_pts = int(tone_sec * fs_hz)
+    t = np.arange(n_pts) / fs_hz
+    t_dec = t[::q]
+
+    # Ignore one second at either end, where both filters see padding
+    keep = (t_dec > 1.0) & (t_dec < tone_sec - 1.0)
+    err = np.zeros(len(tone_freqs_hz))
+    for i, freq in enumerate(tone_freqs_hz):
+        IQ = np.exp(2j * np.pi * freq * t)
+        IQ_dec = func(IQ)
+        ideal = np.exp(2j * np.pi * freq * t_dec)
+        err[i] = np.max(np.abs(IQ_dec[keep] - ideal[keep]))
+    return err
+
+
+def throughput(func):
+    n_pts = int(bench_sec * fs_hz)
+    rng = np.random.RandomState(0)
+    IQ = (rng.randint(-2**15, 2**15, n_pts)
+            + 1j * rng.randint(-2**15, 2**15, n_pts)).astype(np.complex64)
+
+    st = time.time()
+    func(IQ)
+    return n_pts / (time.time() - st)
+
+
+print('Passband error (relative) for tones up to %.0f Hz:'
+        % max(tone_freqs_hz))
+print('%10s %14s %14s' % ('freq (Hz)', 'scipy', 'polyphase'))
+err_scipy = passband_error(scipy_path)
+err_poly = passband_error(polyphase_path)
+for i, freq in enumerate(tone_freqs_hz):
+    print('%10.1f %14.3e %14.3e' % (freq, err_scipy[i], err_poly[i]))
+print('%10s %14.3e %14.3e\n' % ('max', max(err_scipy), max(err_poly)))
+
+print('Throughput for %.0f s of 16 kHz data:' % bench_sec)
+for name, func in [('scipy', scipy_path), ('polyphase', polyphase_path),
+        ('polyphase (streamed)', polyphase_stream_path)]:
+    print('\t%-22s %8.2f Msamples/s' % (name, throughput(func) / 1.0e6))
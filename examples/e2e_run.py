@@ -22,27 +22,32 @@ sys.path.remove('../')
 
 start_time = time.time()
 
-# Create instance with rsr file contents
-rsr_inst = rss.rsr_reader.RSRReader(args.rsr_file, verbose=args.verbose,
-        decimate_16khz_to_1khz=args.decimate_16khz_to_1khz)
-
-# Create instance with geometry parameterst
-geo_inst = rss.occgeo.Geometry(rsr_inst, args.planet, args.spacecraft,
-        args.kernels, verbose=args.verbose, write_file=args.write_file)
-
-# Create instance with calibrated data
-cal_inst = rss.calibration.Calibration(rsr_inst, geo_inst, verbose=args.verbose,
-        write_file=args.write_file, fof_order=args.fof_order, 
-        pnf_order=args.pnf_order, pnf_fittype=args.pnf_fittype,
-        interact=args.interact)
-
-# Create instance with diffraction-limited profile and other
-#   inputs needed for diffraction correction
-dlp_inst_ing, dlp_inst_egr = (
-        rss.calibration.DiffractionLimitedProfile.create_dlps(
-            rsr_inst, geo_inst, cal_inst, args.dr_km_desired, 
-            profile_range = args.profile_range,
-            write_file=args.write_file, verbose=args.verbose))
+# Time the processing stages
+if args.instrument:
+    rss.tools.instrument.enable(trace=(args.trace_file is not None))
+
+# Write binary columns next to the .TAB files
+if args.binary_output:
+    rss.tools.write_output_files.set_binary_output(
+            compress=args.compress_binary)
+
+# Create instances with the geometry, the calibrated data, and the
+#   diffraction-limited profiles and other inputs needed for diffraction
+#   correction. With a checkpoint directory, these are reused from an
+#   earlier run with the same rsr file, kernels and inputs.
+if args.checkpoint_dir is not None:
+    cache = rss.tools.checkpoint.StageCache(args.checkpoint_dir)
+else:
+    cache = None
+geo_inst, cal_inst, dlp_inst_ing, dlp_inst_egr = (
+        rss.tools.checkpoint.create_products(args.rsr_file, args.kernels,
+            args.dr_km_desired, cache=cache, planet=args.planet,
+            spacecraft=args.spacecraft, pt_per_sec=args.pt_per_sec,
+            decimate_16khz_to_1khz=args.decimate_16khz_to_1khz,
+            fof_order=args.fof_order, pnf_order=args.pnf_order,
+            dt_cal=args.dt_cal, pnf_fittype=args.pnf_fittype,
+            interact=args.interact, profile_range=args.profile_range,
+            verbose=args.verbose, write_file=args.write_file))
 
 # Invert profile for full occultation
 if dlp_inst_ing is not None:
@@ -107,6 +112,13 @@ plt.subplots_adjust(top=0.93)
 
 print('Total run time (min): ', str((end_time-start_time)/60.))
 
+if args.instrument:
+    rss.tools.instrument.print_report()
+    if args.instrument_file is not None:
+        rss.tools.instrument.export_json(args.instrument_file)
+    if args.trace_file is not None:
+        rss.tools.instrument.export_chrome_trace(args.trace_file)
+
 plt.show()
 
 """
@@ -5,11 +5,29 @@ Purpose: Provide all inputs to rss_ringoccs, to be imported by e2e_run.py
 ### Global inputs
 verbose = True                      # Print processing steps to terminal
 write_file = True                   # Write output data and label files
+binary_output = False               # Also write each output as binary
+                                    #       columns (.NPZ), read by
+                                    #       CSV_tools without parsing text
+compress_binary = False             # Compress the .NPZ files (smaller, but
+                                    #       they cannot be memory-mapped)
+instrument = False                  # Time the processing stages and count
+                                    #       their work (kept in the
+                                    #       history of each output)
+instrument_file = None              # JSON file to write the timers and
+                                    #       counters to (None for none)
+trace_file = None                   # Chrome trace file of every timed
+                                    #       span (None for none)
 
 ### RSRReader
 rsr_file = '../data/co-s-rss-1-sroc1-v10/cors_0727/SROC1_123/RSR/S10SROE2005123_0740NNNX43RD.2A1'
 decimate_16khz_to_1khz = True       # Decimate 16 kHz rsr file to 1 kHz
 
+### Checkpoints
+checkpoint_dir = None               # Directory to keep the geometry,
+                                    #       calibration and DLP of each rsr
+                                    #       file, reused by later runs with
+                                    #       the same inputs (None for off)
+
 ### Geometry
 kernels = 'Rev007_meta_kernel.ker'  # Path to meta-kernel or list of paths to
                                     #       necessary kernel files
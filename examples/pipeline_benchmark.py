@@ -0,0 +1,308 @@
+"""
+pipeline_benchmark.py
+
+Purpose:
+    Time the processing stages of rss_ringoccs and write the results to
+    a JSON file that can be compared between releases. Every case is
+    timed n_repeat times and the shortest time is kept, together with
+    the counters of the instrument module for that case (points,
+    windows computed, Newton iterations, ...).
+
+    In 'quick' mode only DiffractionCorrection is timed, on a synthetic
+    profile of the diffraction pattern of a square well (sq_well_solve)
+    with the geometry of a Cassini X-band occultation near the Maxwell
+    ringlet, so no RSR file or kernels are needed. In 'full' mode the
+    RSR files of Rev007_list_of_rsr_files.txt are processed as in
+    e2e_run.py, using the inputs of e2e_run_args.py, and each stage is
+    timed on its own: reading the RSR file (at 16 kHz and decimated to
+    1 kHz for 16 kHz files), Geometry, Calibration, and the DLP. Then
+    DiffractionCorrection is timed on the DLP over inversion_range, as
+    well as on the synthetic profile.
+
+    The sweep covers every combination of psitypes, wtypes,
+    resolutions and engines below. Resolutions that the radial spacing
+    of the data cannot support are recorded as skipped.
+
+Usage:
+    python pipeline_benchmark.py [--mode quick|full] [--output FILE]
+                                 [--baseline FILE]
+
+    With --baseline, each case is compared with the same case in an
+    earlier output file, and the script exits with status 1 if any case
+    is slower by more than regression_tol.
+
+Notes:
+    #. For 'full' mode, the files of Rev007_list_of_rsr_files.txt and
+        Rev007_list_of_kernels.txt must have been downloaded, as for
+        e2e_run.py. See p6-7 of rss_ringoccs: User's Guide.
+    #. Timings do not depend on the values of the synthetic data, only
+        on its geometry and sampling.
+    #. Output files are never written. Kernel loading is timed as its
+        own stage, so that it is not counted in the Geometry.
+"""
+import sys
+import os
+import copy
+import time
+import json
+import platform
+import argparse
+import subprocess
+import numpy as np
+
+import e2e_run_args as args
+
+sys.path.append('../')
+import rss_ringoccs as rss
+from rss_ringoccs.diffrec import DiffractionCorrection
+from rss_ringoccs.diffrec import native
+from rss_ringoccs.diffrec.special_functions import sq_well_solve
+from rss_ringoccs.diffrec.special_functions import fresnel_scale
+from rss_ringoccs.tools import instrument
+sys.path.remove('../')
+
+# ***** Begin user input *****
+mode = 'quick'                  # 'quick' (synthetic only) or 'full'
+output_file = 'pipeline_benchmark.json'
+baseline_file = None            # Earlier output to compare with
+regression_tol = 0.25           # Relative slowdown reported as regression
+n_repeat = 3                    # Runs of each reconstruction
+n_repeat_stages = 1             # Runs of each pipeline stage
+psitypes = ['fresnel', 'fresnel4', 'fresnel8', 'full']
+wtypes = ['kbmd20', 'kb25', 'coss']
+resolutions = [1.0, 0.5, 0.25, 0.1, 0.05]      # km
+engines = ['python', 'native']  # 'native' is skipped if it is not built
+
+# Synthetic profile
+syn_dx_km = 0.0125              # Sample spacing (km)
+syn_span = [87000.0, 88200.0]   # Radial extent of the data (km)
+syn_well = [87590.0, 87620.0]   # Edges of the square well (km)
+syn_rng = {'quick': [87600.0, 87610.0],
+           'full': [87550.0, 87650.0]}         # Reconstructed range (km)
+
+# Pipeline
+rsr_file_list = 'Rev007_list_of_rsr_files.txt'
+mpath = '../data/'              # Path to the downloaded RSR files
+dr_km_desired = 0.0125          # DLP spacing, small enough for 0.05 km
+# ***** End user input *****
+
+SPEED_OF_LIGHT_KM = 299792.458
+
+
+class SyntheticDLP(object):
+    def __init__(self):
+        self.rho_km_vals = np.arange(syn_span[0], syn_span[1], syn_dx_km)
+        n_pts = np.size(self.rho_km_vals)
+        self.B_rad_vals = np.zeros(n_pts) + np.deg2rad(23.6)
+        self.D_km_vals = np.linspace(2.18e5, 2.19e5, n_pts)
+        self.phi_rad_vals = np.zeros(n_pts) + np.deg2rad(120.0)
+        self.f_sky_hz_vals = np.zeros(n_pts) + 8.427e9
+        self.rho_dot_kms_vals = np.zeros(n_pts) + 9.5
+        self.t_oet_spm_vals = np.arange(n_pts) * syn_dx_km / 9.5
+        self.t_ret_spm_vals = self.t_oet_spm_vals
+        self.t_set_spm_vals = self.t_oet_spm_vals
+        self.rho_corr_pole_km_vals = np.zeros(n_pts)
+        self.rho_corr_timing_km_vals = np.zeros(n_pts)
+        self.phi_rl_rad_vals = self.phi_rad_vals
+        self.raw_tau_threshold_vals = np.zeros(n_pts)
+        self.history = {}
+        self.rev_info = {}
+
+        # Diffraction pattern of the well, with the Fresnel scale at its
+        #   middle, as it would be seen in the diffracted data
+        lambda_km = SPEED_OF_LIGHT_KM / self.f_sky_hz_vals
+        F = fresnel_scale(lambda_km, self.D_km_vals, self.phi_rad_vals,
+                          self.B_rad_vals)
+        F_well = float(np.interp(0.5*(syn_well[0]+syn_well[1]),
+                                 self.rho_km_vals, F))
+        T_hat = sq_well_solve(self.rho_km_vals, syn_well[0], syn_well[1],
+                              F_well)
+        self.p_norm_vals = np.abs(T_hat) * np.abs(T_hat)
+        self.phase_rad_vals = np.angle(T_hat)
+
+
+def git_commit():
+    try:
+        out = subprocess.check_output(['git', 'rev-parse', 'HEAD'],
+                                      stderr=subprocess.DEVNULL)
+    except (OSError, subprocess.CalledProcessError):
+        return None
+    return out.decode().strip()
+
+
+def environment():
+    return {
+        'rss_ringoccs_version': '1.1',
+        'git_commit': git_commit(),
+        'date': time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+        'host': platform.node(),
+        'platform': platform.platform(),
+        'processor': platform.processor(),
+        'cpu_count': os.cpu_count(),
+        'python': platform.python_version(),
+        'numpy': np.__version__,
+        'native_available': native.NATIVE_AVAILABLE,
+    }
+
+
+def run_case(case, func, repeat):
+    # Shortest of the runs, with the counters of the last run
+    times = []
+    for i in range(repeat):
+        instrument.reset()
+        st = time.perf_counter()
+        out = func()
+        times.append(time.perf_counter() - st)
+    rep = instrument.report()
+    case.update({'status': 'done', 'sec': min(times), 'sec_all': times,
+                 'timers': rep['timers'], 'counters': rep['counters']})
+    print('%-60s %10.4f s' % (case['id'], case['sec']))
+    return out
+
+
+def skip_case(case, reason):
+    case.update({'status': 'skipped', 'reason': reason})
+    print('%-60s    skipped (%s)' % (case['id'], reason))
+
+
+def sweep(dlp, data, rng, dx_km, results):
+    for engine in engines:
+        if (engine == 'native') and (not native.NATIVE_AVAILABLE):
+            continue
+        for psitype in psitypes:
+            for wtype in wtypes:
+                for res in resolutions:
+                    case = {'id': 'diffrec/%s/%s/%s/%g/%s'
+                            % (data, psitype, wtype, res, engine),
+                            'stage': 'diffrec', 'data': data,
+                            'psitype': psitype, 'wtype': wtype,
+                            'res_km': res, 'engine': engine,
+                            'rng_km': list(rng), 'dx_km': dx_km}
+                    results.append(case)
+                    if (res * args.res_factor < 2.0 * dx_km):
+                        skip_case(case, 'res below twice the spacing')
+                        continue
+                    try:
+                        run_case(case, lambda: DiffractionCorrection(
+                            dlp, res, rng=rng, psitype=psitype, wtype=wtype,
+                            res_factor=args.res_factor, engine=engine,
+                            sigma=args.sigma, bfac=args.bfac,
+                            norm=args.norm), n_repeat)
+                    except ValueError as err:
+                        # e.g. the window is wider than the data
+                        skip_case(case, ' '.join(str(err).split()))
+
+
+def pipeline(rsr_file, results):
+    name = os.path.basename(rsr_file)
+
+    def stage(label, func, **params):
+        case = {'id': '%s/%s' % (label, name), 'stage': label,
+                'data': name}
+        case.update(params)
+        results.append(case)
+        return run_case(case, func, n_repeat_stages)
+
+    # Each run clears the pool first, so that it really furnishes the
+    #   kernels, and releases what it acquired
+    def load_kernels():
+        rss.tools.kernel_session.clear()
+        rss.tools.kernel_session.acquire(args.kernels)
+        rss.tools.kernel_session.release()
+
+    stage('kernel_load', load_kernels)
+
+    # Held by the stages below, which find the kernels already loaded
+    rss.tools.kernel_session.acquire(args.kernels)
+
+    rsr_inst = stage('rsr_decode', lambda: rss.rsr_reader.RSRReader(
+        rsr_file, decimate_16khz_to_1khz=True), output_khz=1)
+    if rsr_inst.sample_rate_khz == 16:
+        stage('rsr_decode', lambda: rss.rsr_reader.RSRReader(
+            rsr_file, decimate_16khz_to_1khz=False), output_khz=16)
+
+    geo_inst = stage('geometry', lambda: rss.occgeo.Geometry(
+        rsr_inst, args.planet, args.spacecraft, args.kernels,
+        pt_per_sec=args.pt_per_sec, write_file=False))
+
+    cal_inst = stage('calibration', lambda: rss.calibration.Calibration(
+        rsr_inst, geo_inst, fof_order=args.fof_order,
+        pnf_order=args.pnf_order, dt_cal=args.dt_cal,
+        pnf_fittype=args.pnf_fittype, write_file=False))
+
+    # create_dlps may trim the data of its inputs, so each run gets copies
+    def create_dlps():
+        return rss.calibration.DiffractionLimitedProfile.create_dlps(
+            copy.copy(rsr_inst), geo_inst, copy.copy(cal_inst),
+            dr_km_desired, profile_range=args.profile_range)
+
+    dlps = stage('dlp', create_dlps, dr_km=dr_km_desired)
+    rss.tools.kernel_session.release()
+
+    for dlp_inst, direction in zip(dlps, ['ingress', 'egress']):
+        if dlp_inst is not None:
+            sweep(dlp_inst, '%s/%s' % (name, direction), args.inversion_range,
+                  dr_km_desired, results)
+
+
+def compare(results, baseline):
+    # Ratio of the time of each case to that of the baseline
+    old = dict((case['id'], case) for case in baseline['results']
+               if case.get('status') == 'done')
+    n_slow = 0
+    commit = baseline['environment'].get('git_commit') or 'baseline'
+    print('\n%-60s %10s' % ('Compared with ' + commit[:12], 'ratio'))
+    for case in results:
+        if (case.get('status') != 'done') or (case['id'] not in old):
+            continue
+        ratio = case['sec'] / old[case['id']]['sec']
+        case['baseline_ratio'] = ratio
+        flag = ''
+        if ratio > 1.0 + regression_tol:
+            flag = '  REGRESSION'
+            n_slow += 1
+        print('%-60s %10.3f%s' % (case['id'], ratio, flag))
+    return n_slow
+
+
+def main():
+    parser = argparse.ArgumentParser(description='rss_ringoccs benchmarks')
+    parser.add_argument('--mode', choices=['quick', 'full'], default=mode)
+    parser.add_argument('--output', default=output_file)
+    parser.add_argument('--baseline', default=baseline_file)
+    opts = parser.parse_args()
+
+    instrument.enable()
+    results = []
+
+    if (opts.mode == 'full'):
+        files = [mpath + line.strip() for line in open(rsr_file_list, 'r')
+                 if line.strip() and not line.strip().endswith('.LBL')]
+        for rsr_file in files:
+            pipeline(rsr_file, results)
+
+    sweep(SyntheticDLP(), 'synthetic', syn_rng[opts.mode], syn_dx_km,
+          results)
+
+    report = {'environment': environment(), 'mode': opts.mode,
+              'n_repeat': n_repeat, 'n_repeat_stages': n_repeat_stages,
+              'peak_rss_bytes': instrument.peak_rss_bytes(),
+              'results': results}
+
+    n_slow = 0
+    if opts.baseline is not None:
+        with open(opts.baseline, 'r') as f:
+            n_slow = compare(results, json.load(f))
+
+    with open(opts.output, 'w') as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+    print('\nResults written to ' + opts.output)
+
+    if (n_slow > 0):
+        print('%d cases slower than the baseline by more than %d%%'
+              % (n_slow, int(round(100*regression_tol))))
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,176 @@
+"""
+psitype_benchmark.py
+
+Purpose:
+    Time the fresnel3...fresnel8 expansions of psi. The first test
+    compares, for one window, the expansion in powers of z = x/D that
+    DiffractionCorrection used to evaluate at every point against the
+    Horner scheme it uses now, with kD/D^(k+2) folded into the
+    coefficients. The second test runs DiffractionCorrection on a
+    synthetic data set for every psitype, with the Python loop and,
+    if it has been built with config_src.sh, the native engine. No
+    RSR file or kernels are needed.
+
+Notes:
+    #. The synthetic data set has the geometry of a Cassini X-band
+        occultation near the Maxwell ringlet, with unit power and zero
+        phase. The timings do not depend on the data values.
+    #. The largest relative difference between the two schemes is
+        printed alongside the timings. It should be near 1e-15.
+"""
+import sys
+import time
+import numpy as np
+
+sys.path.append('../')
+from rss_ringoccs.diffrec import DiffractionCorrection
+from rss_ringoccs.diffrec import native
+sys.path.remove('../')
+
+# ***** Begin user input *****
+psitypes = ['fresnel3', 'fresnel4', 'fresnel6', 'fresnel8']
+n_window = 2001                 # Points in the window for the first test
+n_repeat = 2000                 # Windows evaluated per psitype
+rng = [87410.0, 87610.0]        # Range for the DiffractionCorrection test
+res = 1.0                       # Resolution (km)
+dx_km = 0.25                    # Sample spacing of the synthetic data (km)
+# ***** End user input *****
+
+
+class SyntheticDLP(object):
+    def __init__(self):
+        self.rho_km_vals = np.arange(87000.0, 88000.0, dx_km)
+        n_pts = np.size(self.rho_km_vals)
+        self.p_norm_vals = np.ones(n_pts)
+        self.phase_rad_vals = np.zeros(n_pts)
+        self.B_rad_vals = np.zeros(n_pts) + np.deg2rad(23.6)
+        self.D_km_vals = np.linspace(2.18e5, 2.19e5, n_pts)
+        self.phi_rad_vals = np.zeros(n_pts) + np.deg2rad(120.0)
+        self.f_sky_hz_vals = np.zeros(n_pts) + 8.427e9
+        self.rho_dot_kms_vals = np.zeros(n_pts) + 9.5
+        self.t_oet_spm_vals = np.arange(n_pts) * dx_km / 9.5
+        self.t_ret_spm_vals = self.t_oet_spm_vals
+        self.t_set_spm_vals = self.t_oet_spm_vals
+        self.rho_corr_pole_km_vals = np.zeros(n_pts)
+        self.rho_corr_timing_km_vals = np.zeros(n_pts)
+        self.phi_rl_rad_vals = self.phi_rad_vals
+        self.raw_tau_threshold_vals = np.zeros(n_pts)
+        self.history = {}
+        self.rev_info = {}
+
+
+def coeffs(psitype, B, phi):
+    # Same polynomials as DiffractionCorrection.__legendre_coeffs
+    cosb = np.cos(B)
+    cosp = np.cos(phi)
+    sinp = np.sin(phi)
+    A_2 = 0.5*cosb*cosb*sinp*sinp/(1.0-cosb*cosb*sinp*sinp)
+    P_1 = cosb*cosp
+    P12 = P_1*P_1
+    P_2 = (3.0*P12-1.0)*0.5
+    P_3 = (5.0*P12-3.0)*0.5*P_1
+    P_4 = (35.0*P12*P12-30.0*P12+3.0)/8.0
+    P_5 = P_1*(63.0*P12*P12-70.0*P12+15.0)/8.0
+    P_6 = (231.0*P12*P12*P12-315.0*P12*P12+105.0*P12-5.0)/16.0
+    b = [(1.0-P12)*0.5, (P_1-P_1*P_2)/3.0, (P_2-P_1*P_3)*0.25,
+         (P_3-P_1*P_4)*0.2, (P_4-P_1*P_5)/6.0, (P_5-P_1*P_4)/7.0,
+         (P_6-P_1*P_5)/8.0]
+    if (psitype == 'fresnel3'):
+        return A_2, b[:2], [P12, 2.0*P_1*P_2]
+    elif (psitype == 'fresnel4'):
+        return A_2, b[:3], [P12, 2.0*P_1*P_2, P_2*P_2]
+    elif (psitype == 'fresnel6'):
+        return A_2, b[:5], [P12, 2.0*P_1*P_2, P_2*P_2+2.0*P_1*P_3,
+                            2.0*P_2*P_3, P_3*P_3]
+    else:
+        return A_2, b, [P12, 2.0*P_1*P_2, 2.0*P_1*P_3+P_2*P_2,
+                        2.0*P_1*P_4+2.0*P_2*P_3, 2.0*P_2*P_4+P_3*P_3,
+                        2.0*P_3*P_4, P_4*P_4]
+
+
+def psi_powers(x, d, kD, A_2, b, C):
+    # Fresh powers of x and of D at every point, as the loops used to do
+    x_k = [np.ones(np.size(x)), x]
+    for k in range(2, len(b)):
+        x_k.append(x_k[-1]*x)
+    psi_vals = b[0]-A_2*C[0]
+    for k in range(1, len(b)):
+        psi_vals += (x_k[k]/d**k)*(b[k]-A_2*C[k])
+    psi_vals *= kD*(x_k[1]*x_k[1])/(d*d)
+    return psi_vals
+
+
+def psi_horner(x, d, kD, A_2, b, C):
+    # Coefficients of x^(k+2) once per point, then one Horner pass
+    scale = kD/(d*d)
+    a_b, a_C = [], []
+    for k in range(len(b)):
+        a_b.append(b[k]*scale)
+        a_C.append(C[k]*scale)
+        scale /= d
+    if np.size(A_2) == 1:
+        a_b = [a_b[k]-A_2*a_C[k] for k in range(len(b))]
+        a_C = None
+    psi_vals = np.zeros(np.size(x)) + a_b[-1]
+    for k in range(len(b)-2, -1, -1):
+        psi_vals *= x
+        psi_vals += a_b[k]
+    if a_C is not None:
+        p_C = np.zeros(np.size(x)) + a_C[-1]
+        for k in range(len(b)-2, -1, -1):
+            p_C *= x
+            p_C += a_C[k]
+        p_C *= A_2
+        psi_vals -= p_C
+    psi_vals *= x
+    psi_vals *= x
+    return psi_vals
+
+
+def window_test(psitype):
+    x = (np.arange(n_window) - (n_window-1)/2) * dx_km
+    d = 2.185e5
+    kD = 2.0*np.pi*d/(299792.458/8.427e9)
+    A_2, b, C = coeffs(psitype, np.deg2rad(23.6), np.deg2rad(120.0))
+
+    # fresnel6 and fresnel8 take A_2 across the window
+    if psitype in ['fresnel6', 'fresnel8']:
+        A_2 = A_2 + np.zeros(n_window)
+
+    times = []
+    for func in [psi_powers, psi_horner]:
+        st = time.time()
+        for i in range(n_repeat):
+            psi_vals = func(x, d, kD, A_2, b, C)
+        times.append((time.time() - st) / n_repeat)
+
+    ref = psi_powers(x, d, kD, A_2, b, C)
+    err = np.max(np.abs(psi_horner(x, d, kD, A_2, b, C) - ref))
+    return times, err / np.max(np.abs(ref))
+
+
+def reconstruction_time(dlp, psitype, engine):
+    st = time.time()
+    DiffractionCorrection(dlp, res, rng=rng, psitype=psitype, engine=engine)
+    return time.time() - st
+
+
+print('psi over one %d point window:' % n_window)
+print('%10s %14s %14s %9s %12s' % ('psitype', 'powers (us)', 'horner (us)',
+                                    'speedup', 'rel. diff'))
+for psitype in psitypes:
+    (t_pow, t_hor), err = window_test(psitype)
+    print('%10s %14.2f %14.2f %9.2f %12.3e' % (psitype, t_pow*1.0e6,
+                                                t_hor*1.0e6, t_pow/t_hor, err))
+
+dlp = SyntheticDLP()
+engines = ['python']
+if native.NATIVE_AVAILABLE:
+    engines.append('native')
+
+print('\nDiffractionCorrection, %.1f km over %.0f-%.0f km:'
+      % (res, rng[0], rng[1]))
+print('%10s' % 'psitype' + ''.join(['%14s' % (e + ' (s)') for e in engines]))
+for psitype in psitypes:
+    row = [reconstruction_time(dlp, psitype, e) for e in engines]
+    print('%10s' % psitype + ''.join(['%14.3f' % t for t in row]))
@@ -0,0 +1,75 @@
+"""
+sincos_benchmark.py
+
+Purpose:
+    Time the inner sum of the Fresnel inversion, the sum over one window
+    of w_func*exp(-i psi)*T, for windows of 100 to 100,000 points. The
+    numpy expression used by DiffractionCorrection is compared against
+    native.window_sum, which forms the kernel with the vectorized sine
+    and cosine of the native engine a block at a time, without storing
+    it. The native engine must have been built with config_src.sh. No
+    RSR file or kernels are needed.
+
+Notes:
+    #. psi is the quadratic Fresnel phase across a window of w_km
+        centered on the point being reconstructed, sampled with the
+        number of points listed, so its range does not depend on the
+        window size.
+    #. The relative difference between the two sums is printed with the
+        timings. It should be near 1e-15.
+"""
+import sys
+import time
+import numpy as np
+
+sys.path.append('../')
+from rss_ringoccs.diffrec import native
+sys.path.remove('../')
+
+# ***** Begin user input *****
+n_windows = [100, 300, 1000, 3000, 10000, 30000, 100000]
+w_km = 20.0                     # Window width (km)
+F_km = 1.5                      # Fresnel scale (km)
+n_total = 2000000               # Points summed per window size
+# ***** End user input *****
+
+if not native.NATIVE_AVAILABLE:
+    raise ImportError("Build the native engine with config_src.sh first.")
+
+
+def numpy_sum(psi, w_func, T):
+    ker = w_func*np.exp(-1j*psi)
+    return np.sum(ker), np.sum(ker*T)
+
+
+def native_sum(psi, w_func, T):
+    return native.window_sum(psi, w_func, T)
+
+
+def window(nw):
+    x = (np.arange(nw) - (nw-1)/2) * w_km / nw
+    psi = 0.5*np.pi*(x/F_km)**2
+    w_func = np.cos(np.pi*x/w_km)**2
+    rng = np.random.RandomState(0)
+    T = np.exp(1j*rng.uniform(-np.pi, np.pi, nw))*rng.uniform(0.5, 1.0, nw)
+    return psi, w_func, T
+
+
+print('%10s %14s %14s %9s %12s' % ('points', 'numpy (us)', 'native (us)',
+                                    'speedup', 'rel. diff'))
+for nw in n_windows:
+    psi, w_func, T = window(nw)
+    n_repeat = max(n_total // nw, 10)
+
+    times = []
+    for func in [numpy_sum, native_sum]:
+        st = time.time()
+        for i in range(n_repeat):
+            sums = func(psi, w_func, T)
+        times.append((time.time() - st) / n_repeat)
+
+    ref = numpy_sum(psi, w_func, T)[1]
+    err = np.abs(native_sum(psi, w_func, T)[1] - ref) / np.abs(ref)
+    print('%10d %14.2f %14.2f %9.2f %12.3e' % (nw, times[0]*1.0e6,
+                                                times[1]*1.0e6,
+                                                times[0]/times[1], err))
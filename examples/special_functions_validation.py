@@ -0,0 +1,101 @@
+"""
+special_functions_validation.py
+
+Purpose:
+    Check the compiled Fresnel integrals and Kaiser-Bessel windows of
+    the native engine against the Python expressions they replace.
+    native.fresnel_cs is compared with special_functions._fresnel_cs_erf,
+    which uses the scipy.special Error Function as fresnel_cos and
+    fresnel_sin did, and native.window with the scipy.special.iv form
+    of each window in window_functions.py. The largest differences are
+    printed, and the script exits with status 1 if any is above tol.
+    The native engine must have been built with config_src.sh. No RSR
+    file or kernels are needed.
+
+Notes:
+    #. The difference of the Fresnel integrals is absolute, since they
+        tend to 1/2. That of the windows is relative to the window,
+        whose largest value is 1.
+"""
+import sys
+import numpy as np
+from scipy.special import iv
+
+sys.path.append('../')
+from rss_ringoccs.diffrec import native
+from rss_ringoccs.diffrec.special_functions import _fresnel_cs_erf
+sys.path.remove('../')
+
+# ***** Begin user input *****
+x_max = 50.0                    # Fresnel integrals on [-x_max, x_max]
+n_x = 200001                    # Number of points
+windows = [(1.0, 0.01), (10.0, 0.25), (37.3, 0.0125)]   # (w_in, dx)
+alphas = [1.0, 2.0, 3.5, 6.0]   # al for kbal and kbmdal
+tol = 1.0e-12
+# ***** End user input *****
+
+if not native.NATIVE_AVAILABLE:
+    raise ImportError("Build the native engine with config_src.sh first.")
+
+# Alpha and normalization of the windows, as in window_functions.py
+KB_WINDOWS = {"kb20": (2.0*np.pi, 0.0, 87.10850209627940),
+              "kb25": (2.5*np.pi, 0.0, 373.02058499037486),
+              "kb35": (3.5*np.pi, 0.0, 7257.7994923041760),
+              "kbmd20": (2.0*np.pi, 1.0, 87.10850209627940 - 1.0),
+              "kbmd25": (2.5*np.pi, 1.0, 373.02058499037486 - 1.0)}
+
+
+def kaiser_bessel(w_in, dx, alpha, shift, norm):
+    nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
+    x = (np.arange(nw_pts) - ((nw_pts - 1) / 2.0)) * dx / w_in
+    return (iv(0.0, alpha * np.sqrt(1.0 - 4.0*x*x)) - shift) / norm
+
+
+def window_diff(w_ref, w_nat):
+    if (np.size(w_ref) != np.size(w_nat)):
+        return np.inf
+    return np.max(np.abs(w_nat - w_ref))
+
+
+n_bad = 0
+print('%-30s %12s' % ('function', 'max diff'))
+
+x = np.linspace(-x_max, x_max, n_x)
+x = np.concatenate([x, [0.0, 1.0e-300, 1.0e-8, 1.0e3, -1.0e4]])
+C_ref, S_ref = _fresnel_cs_erf(x)
+C_nat, S_nat = native.fresnel_cs(x)
+for name, diff in [('fresnel_cos', np.max(np.abs(C_nat - C_ref))),
+                   ('fresnel_sin', np.max(np.abs(S_nat - S_ref)))]:
+    flag = ''
+    if not (diff <= tol):
+        flag = '  FAILED'
+        n_bad += 1
+    print('%-30s %12.3e%s' % (name, diff, flag))
+
+for w_in, dx in windows:
+    cases = []
+    for wtype in sorted(KB_WINDOWS):
+        cases.append((wtype, kaiser_bessel(w_in, dx, *KB_WINDOWS[wtype]),
+                      native.window(wtype, w_in, dx)))
+    for al in alphas:
+        alpha = al * np.pi
+        cases.append(('kbal %g' % al,
+                      kaiser_bessel(w_in, dx, alpha, 0.0, iv(0.0, alpha)),
+                      native.window('kbal', w_in, dx, alpha=alpha)))
+        cases.append(('kbmdal %g' % al,
+                      kaiser_bessel(w_in, dx, alpha, 1.0,
+                                    iv(0.0, alpha) - 1.0),
+                      native.window('kbmdal', w_in, dx, alpha=alpha)))
+
+    for name, w_ref, w_nat in cases:
+        diff = window_diff(w_ref, w_nat)
+        flag = ''
+        if not (diff <= tol):
+            flag = '  FAILED'
+            n_bad += 1
+        print('%-30s %12.3e%s' % ('%s (%g, %g)' % (name, w_in, dx), diff,
+                                  flag))
+
+if (n_bad > 0):
+    print('%d checks above the tolerance %g' % (n_bad, tol))
+    sys.exit(1)
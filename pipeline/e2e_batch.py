@@ -3,93 +3,167 @@ import sys
 sys.path.append('../')
 import rss_ringoccs as rss
 sys.path.remove('../')
-import traceback
+from rss_ringoccs.tools import batch_scheduler
+from concurrent.futures import ThreadPoolExecutor
 import time
+import os
 
-err_file = sys.argv[0].split('.')[0] + '.err'
-fail_file = open('../output/' + err_file, 'w')
-files = [args.mpath+line.strip('\n') for line in open(
-                args.rsr_file_list,'r').readlines()]
-
-# files with bad headers (to exclude)
-skips = [args.mpath for x in args.skips]
-
-nfiles = len(files)
-init_time = time.time()
-
-for ind in range(nfiles):
-    
-    print('\nn='+str(ind))
-    rsr_file = files[ind]
-
-    # exclude 16 kHz files
-    if rsr_file[-1] == '2' and not args.with16:
-        print('SKIPPING 16 KHZ FILE: ' + rsr_file)
-        continue
-
-    # exclude files with bad headers
-    if rsr_file in args.skips:
-        print('SKIPPING FILE WITH BAD HEADER: '+rsr_file)
-        continue
-    try:
-        st = time.time()
-    
-        # print RSR file
-        print(rsr_file)
-        # Create instance with rsr file contents
-        rsr_inst = rss.rsr_reader.RSRReader(rsr_file, verbose=args.verbose,
-                decimate_16khz_to_1khz=args.decimate_16khz_to_1khz)
-            
-        # Create instance with geometry parameters
-        geo_inst = rss.occgeo.Geometry(rsr_inst, args.planet, args.spacecraft,
-                args.kernels, verbose=args.verbose, write_file=args.write_file)
-            
-        # Create instance with calibrated data
-        cal_inst = rss.calibration.Calibration(rsr_inst, geo_inst, 
-                verbose=args.verbose, write_file=args.write_file, 
-                fof_order=args.fof_order, pnf_order=args.pnf_order, 
-                pnf_fittype=args.pnf_fittype, interact=args.interact)
-        
-        # Create instance with diffraction-limited profile and other
-        #   inputs needed for diffraction correction
-        dlp_inst_ing, dlp_inst_egr = (
-                rss.calibration.DiffractionLimitedProfile.create_dlps(
-                    rsr_inst, geo_inst, cal_inst, args.dr_km_desired,
-                    profile_range = args.profile_range,
-                    write_file=args.write_file, verbose=args.verbose))
-        # Invert profile for full occultation
-        if dlp_inst_ing is not None:
-            tau_inst = (rss.diffrec.DiffractionCorrection(
-                    dlp_inst_ing, args.res_km,
-                    rng=args.inversion_range, res_factor=args.res_factor,
-                    psitype=args.psitype, wtype=args.wtype, fwd=args.fwd,
-                    norm=args.norm, bfac=args.bfac, write_file=args.write_file,
-                    verbose=args.verbose))
-            rss.tools.plot_summary_doc_v2(geo_inst, cal_inst, dlp_inst_ing,
-                    tau_inst)
-        if dlp_inst_egr is not None:
-            tau_inst = (rss.diffrec.DiffractionCorrection(
-                    dlp_inst_egr, args.res_km,
-                    rng=args.inversion_range, res_factor=args.res_factor,
-                    psitype=args.psitype, wtype=args.wtype, fwd=args.fwd,
-                    norm=args.norm, bfac=args.bfac, write_file=args.write_file,
-                    verbose=args.verbose))
-            rss.tools.plot_summary_doc_v2(geo_inst, cal_inst, dlp_inst_egr,
-                    tau_inst)
-        
-        # if verbose, let user know this file processed successfuly
-        et = time.time()
-        run_time = str((et-st)/60.)
-        print('File processing time (min): ' + str(run_time))
-    except:
-        tb = traceback.format_exc()
-        fail_file.write('-'*48+'\n')
-        print(tb)
-        fail_file.write('  '+rsr_file+'\n'+'-'*36+'\n\n'+ 'n='+
-                         str(ind)+'\n'+ tb+'\n')
-
-
-final_time = time.time()
-total_batch_time = (final_time - init_time)/60./60.
-print('Total processing time (hrs): ' + str(total_batch_time))
-fail_file.close()
+err_file = '../output/' + sys.argv[0].split('.')[0] + '.err'
+done_file = '../output/' + sys.argv[0].split('.')[0] + '.done'
+
+# Checkpoint cache of each worker, set by init_worker
+_cache = [None]
+
+def init_worker():
+    # Keep the window cache on disk so it is shared between batch runs.
+    if args.cache_windows and args.window_cache_dir is not None:
+        rss.diffrec.window_functions.window_cache.set_cache_dir(
+                args.window_cache_dir)
+
+    # Load the kernels once and keep them loaded for every file this
+    #   worker processes.
+    rss.tools.kernel_session.acquire(args.kernels)
+
+    if args.binary_output:
+        rss.tools.write_output_files.set_binary_output(
+                compress=args.compress_binary)
+
+    if args.checkpoint_dir is not None:
+        _cache[0] = rss.tools.checkpoint.StageCache(args.checkpoint_dir)
+
+    if args.instrument:
+        rss.tools.instrument.enable(trace=(args.instrument_dir is not None))
+        if (args.instrument_dir is not None) and (
+                not os.path.exists(args.instrument_dir)):
+            os.makedirs(args.instrument_dir, exist_ok=True)
+
+def invert(dlp_inst):
+    return rss.diffrec.DiffractionCorrection(
+            dlp_inst, args.res_km,
+            rng=args.inversion_range, res_factor=args.res_factor,
+            psitype=args.psitype, wtype=args.wtype, fwd=args.fwd,
+            norm=args.norm, bfac=args.bfac, write_file=args.write_file,
+            cache_windows=args.cache_windows, verbose=args.verbose)
+
+def process_file(rsr_file):
+    st = time.time()
+
+    # print RSR file
+    print(rsr_file)
+
+    # Timers and counters of this file only
+    rss.tools.instrument.reset()
+    rss.diffrec.window_functions.window_cache.reset_stats()
+
+    # Create instances with the geometry, the calibrated data, and the
+    #   diffraction-limited profiles and other inputs needed for
+    #   diffraction correction, or reuse them from an earlier batch
+    geo_inst, cal_inst, dlp_inst_ing, dlp_inst_egr = (
+            rss.tools.checkpoint.create_products(rsr_file, args.kernels,
+                args.dr_km_desired, cache=_cache[0], planet=args.planet,
+                spacecraft=args.spacecraft, pt_per_sec=args.pt_per_sec,
+                decimate_16khz_to_1khz=args.decimate_16khz_to_1khz,
+                decimate_mode=args.decimate_mode, fof_order=args.fof_order,
+                pnf_order=args.pnf_order, dt_cal=args.dt_cal,
+                pnf_fittype=args.pnf_fittype, interact=args.interact,
+                profile_range=args.profile_range, verbose=args.verbose,
+                write_file=args.write_file))
+    dlps = [dlp for dlp in [dlp_inst_ing, dlp_inst_egr] if dlp is not None]
+
+    # Invert the ingress and egress profiles at the same time. The native
+    #   engine releases the GIL, so the two run in parallel.
+    if args.concurrent_profiles and (len(dlps) > 1):
+        with ThreadPoolExecutor(len(dlps)) as executor:
+            taus = list(executor.map(invert, dlps))
+    else:
+        taus = [invert(dlp) for dlp in dlps]
+
+    # Plot one after the other, matplotlib is not thread safe
+    for dlp_inst, tau_inst in zip(dlps, taus):
+        rss.tools.plot_summary_doc_v2(geo_inst, cal_inst, dlp_inst, tau_inst)
+
+    run_time = (time.time() - st)/60.
+    if args.instrument and (args.instrument_dir is not None):
+        name = os.path.join(args.instrument_dir, os.path.basename(rsr_file))
+        rss.tools.instrument.export_json(name + '.json')
+        rss.tools.instrument.export_chrome_trace(name + '.trace.json')
+    if args.cache_windows:
+        print('Window cache for this file: %(hits)d hits, %(disk_hits)d '
+              'disk hits, %(misses)d misses' %
+              rss.diffrec.window_functions.window_cache.stats())
+    return run_time
+
+def select_files():
+    files = [args.mpath+line.strip('\n') for line in open(
+                    args.rsr_file_list,'r').readlines()]
+
+    # files with bad headers (to exclude)
+    skips = [args.mpath+x for x in args.skips]
+
+    jobs = []
+    for rsr_file in files:
+        # exclude 16 kHz files
+        if rsr_file[-1] == '2' and not args.with16:
+            print('SKIPPING 16 KHZ FILE: ' + rsr_file)
+            continue
+
+        # exclude files with bad headers
+        if rsr_file in skips:
+            print('SKIPPING FILE WITH BAD HEADER: '+rsr_file)
+            continue
+        jobs.append(rsr_file)
+
+    # only run what an earlier batch did not finish
+    if args.resume:
+        if not os.path.exists(done_file):
+            print('NO .done FILE: RESUMING FROM THE .err FILE')
+        jobs = batch_scheduler.resume_jobs(jobs, done_file,
+                err_file=err_file, batch_files=files)
+        print('RESUMING BATCH: %d files left' % len(jobs))
+    return files, jobs
+
+def main():
+    init_time = time.time()
+    files, jobs = select_files()
+    costs = [batch_scheduler.job_cost(f) for f in jobs]
+
+    # A resumed batch keeps the failures and completed files from before
+    fail_file = open(err_file, 'a' if args.resume else 'w')
+    done = open(done_file, 'a' if args.resume else 'w')
+
+    # With one worker the jobs run in this process
+    results = batch_scheduler.run_batch(jobs, process_file, costs=costs,
+            nworkers=args.nworkers, initializer=init_worker,
+            queue_dir=args.queue_dir, queue_timeout=args.queue_timeout)
+
+    for rsr_file, status, output in results:
+        ind = files.index(rsr_file)
+        print('\nn='+str(ind))
+        if status == 'done':
+            print(rsr_file)
+            # if verbose, let user know this file processed successfuly
+            print('File processing time (min): ' + str(output))
+            done.write(rsr_file + '\n')
+            done.flush()
+        elif status == 'failed':
+            print(output)
+            fail_file.write('-'*48+'\n')
+            fail_file.write('  '+rsr_file+'\n'+'-'*36+'\n\n'+ 'n='+
+                             str(ind)+'\n'+ output+'\n')
+            fail_file.flush()
+        else:
+            print('SKIPPING FILE CLAIMED BY ANOTHER BATCH: ' + rsr_file)
+
+    if args.nworkers <= 1:
+        rss.tools.kernel_session.release()
+        print('Kernel loads: %(kernel_loads)d, load time (sec): '
+              '%(kernel_load_time_sec).3f' % rss.tools.kernel_session.info())
+
+    final_time = time.time()
+    total_batch_time = (final_time - init_time)/60./60.
+    print('Total processing time (hrs): ' + str(total_batch_time))
+    fail_file.close()
+    done.close()
+
+if __name__ == '__main__':
+    main()
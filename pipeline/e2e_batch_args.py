@@ -6,14 +6,48 @@ Purpose: Provide all inputs to batch run, to be imported by e2e_batch.py
 with16 = False                      # Process 16 kHz files (use False to skip)
 mpath = '../data/'                  # Path to location of data files
 rsr_file_list = '../tables/list_of_rsr_files_before_USO_failure_to_dl_v2.txt'
+nworkers = 1                        # Number of files processed at once
+resume = False                      # Only process the files that the
+                                    #       last batch did not complete
+                                    #       (see .done, or .err for a
+                                    #       batch without a .done file)
+queue_dir = None                    # Directory shared with other batches,
+                                    #       e.g. on other machines, to
+                                    #       split the files between them
+                                    #       (None for this batch only)
+queue_timeout = 24.*3600.           # Seconds after which a file claimed
+                                    #       by a batch on another machine
+                                    #       is taken as abandoned (None
+                                    #       to never take it over)
+concurrent_profiles = True          # Invert ingress and egress at once
 skips = ['co-s-rss-1-sroc8-v10/cors_0745/SROC8_239/RSR/S43SROI2008239_1410NNNX63RD.1A1', 'co-s-rss-1-sroc8-v10/cors_0745/SROC8_239/RSR/S43SROI2008239_1410NNNS63RD.1B1']
 
 ### Global inputs
 verbose    = False                  # Print processing steps to terminal
 write_file = True                   # Write output data and label files
+binary_output = False               # Also write each output as binary
+                                    #       columns (.NPZ), read by
+                                    #       CSV_tools without parsing text
+compress_binary = False             # Compress the .NPZ files (smaller, but
+                                    #       they cannot be memory-mapped)
+instrument = False                  # Time the processing stages and count
+                                    #       their work (kept in the
+                                    #       history of each output)
+instrument_dir = None               # Directory to write the timers and
+                                    #       counters (.json) and a Chrome
+                                    #       trace (.trace.json) of each
+                                    #       rsr file to (None for none)
 
 ### RSRReader
 decimate_16khz_to_1khz = True       # Decimate 16 kHz rsr file to 1 kHz
+decimate_mode = 'scipy'             # 16 kHz decimation filter ('scipy' or
+                                    #       'polyphase')
+
+### Checkpoints
+checkpoint_dir = None               # Directory to keep the geometry,
+                                    #       calibration and DLP of each rsr
+                                    #       file, reused by later runs with
+                                    #       the same inputs (None for off)
 
 ### Geometry
 kernels = '../tables/e2e_kernels.ker'  # Path to meta-kernel or list of paths to
@@ -49,3 +83,8 @@ fwd = False                         # Compute forward model
 norm = True                         # Normalize reconstructed complex
                                     #       transmittance by window width
 bfac = True                         # Use input sigma in window calculation
+cache_windows = False               # Reuse windows from the process-wide
+                                    #       window cache
+window_cache_dir = None             # Directory to keep cached windows on
+                                    #       disk across runs (None for
+                                    #       memory only)
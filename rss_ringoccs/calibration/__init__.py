@@ -15,6 +15,7 @@
 
 """
 
+from .signal_spectra import SignalSpectra
 from .calc_freq_offset import calc_freq_offset
 from .calibration_class import Calibration
 from .freq_offset_fit import FreqOffsetFit
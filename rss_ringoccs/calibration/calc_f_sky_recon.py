@@ -15,10 +15,12 @@ References:
 """
 
 import numpy as np
+from scipy.interpolate import splrep, splev
 from spiceypy import spiceypy as spice
 import sys
 
 from ..tools.spm_to_et import spm_to_et
+from ..tools.spice_session import kernel_session
 
 # Product of the gravitational constant by the Sun mass
 MUS = 1.3271244002331E+11
@@ -47,7 +49,8 @@ GM_SSB = [
     8.9781370309840E+03]  # 606 (Titan) from cpck30Mar2016.tpc
 
 
-def calc_f_sky_recon(f_spm, rsr_inst, sc_name, f_uso, kernels):
+def calc_f_sky_recon(f_spm, rsr_inst, sc_name, f_uso, kernels,
+        spline_tol=None, coarse_step=64):
     """
     Calculates sky frequency at given times.
 
@@ -64,13 +67,24 @@ def calc_f_sky_recon(f_spm, rsr_inst, sc_name, f_uso, kernels):
         :kernels (*list*):
             String list of full path name to set of kernels
 
+    Keyword Arguments:
+        :spline_tol (*float*):
+            If set, sky frequency is only computed on a coarse grid of
+            f_spm and interpolated with a cubic spline. The grid starts at
+            every coarse_step points and is refined by factors of 2 until
+            the spline reproduces the midpoints of the grid to within
+            spline_tol Hz. If None, which is the default, every point is
+            computed.
+        :coarse_step (*int*):
+            Spacing, in points of f_spm, of the starting grid used when
+            spline_tol is set. Default is 64.
+
     Returns:
         :RF (*np.ndarray*): Reconstructed sky frequency computed from
         spacecraft telemetry and oscillator frequency
     """
 
-    spice.kclear()
-    spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     et_vals = spm_to_et(f_spm, rsr_inst.doy, rsr_inst.year, kernels=kernels)
 
@@ -82,59 +96,131 @@ def calc_f_sky_recon(f_spm, rsr_inst, sc_name, f_uso, kernels):
 
     n_times = len(et_vals)
 
-    # Reconstructed sky frequency array
-    RF = np.zeros(n_times)
-
-    for i in range(n_times):
-        et = et_vals[i]
-        [etsc, _lt] = spice.ltime(et, rs_code, '<-', sc_code)
-        A23 = derlt(sc_code, etsc, rs_code, et)
-        B3 = derpt(et, rs_code)
-        B2 = derpt(etsc, sc_code)
-        temp = (B2 - B3)/(1.0 - B3)
-        y = -A23*temp + A23 + temp
-        y *= f_uso
-        RF[i] = f_uso - y
+    if (spline_tol is None) or (n_times < 8):
+        return f_sky_recon_et(et_vals, sc_code, rs_code, f_uso)
+
+    # Reconstructed sky frequency array, NaN where not yet computed
+    RF = np.full(n_times, np.nan)
+
+    step = max(int(coarse_step), 2)
+    while step > 1:
+        nodes = np.unique(np.append(np.arange(0, n_times, step), n_times-1))
+        mids = (nodes[:-1] + nodes[1:])//2
+
+        # Only compute points that earlier passes have not
+        todo = np.union1d(nodes, mids)
+        todo = todo[np.isnan(RF[todo])]
+        if len(todo) > 0:
+            RF[todo] = f_sky_recon_et(et_vals[todo], sc_code, rs_code, f_uso)
+
+        if len(nodes) > 3:
+            # Spline in time relative to the first point, and in frequency
+            #   relative to f_uso, for better conditioning
+            t_nodes = et_vals[nodes] - et_vals[0]
+            RF_spl_coef = splrep(t_nodes, RF[nodes] - f_uso)
+            RF_mids = splev(et_vals[mids] - et_vals[0], RF_spl_coef) + f_uso
+            if np.max(np.abs(RF_mids - RF[mids])) <= spline_tol:
+                RF_spl = splev(et_vals - et_vals[0], RF_spl_coef) + f_uso
+                computed = ~np.isnan(RF)
+                RF_spl[computed] = RF[computed]
+                return RF_spl
+
+        step //= 2
+
+    # No grid was accurate enough, so compute the remaining points
+    todo = np.isnan(RF)
+    RF[todo] = f_sky_recon_et(et_vals[todo], sc_code, rs_code, f_uso)
 
     return RF
 
 
-def derlt(sc_code, etsc, rs_code, et):
+def f_sky_recon_et(et_vals, sc_code, rs_code, f_uso):
     """
     Arguments:
+        :et_vals (*np.ndarray*): Ephemeris times at which the signal is
+                        received.
         :sc_code (*int*): Spacecraft NAIF ID
-        :etsc (*float*): Epoch (in ephemeris seconds past J2000 TDB)
-                        at which the signal arrives at the receiver
-                        station
         :rs_code (*int*): Receiving station NAIF ID
-        :et (*float*): Ephemeris time
+        :f_uso (*float*): USO sky frequency for the event and the right band
+
+    Returns:
+        :RF (*np.ndarray*): Reconstructed sky frequency at et_vals
+    """
+
+    et_vals = np.atleast_1d(np.asarray(et_vals, dtype=float))
+
+    # spice.ltime is not vectorized, but is a single call per point, and
+    #   all of the states below are retrieved in one call per body
+    etsc_vals = np.array([spice.ltime(et, rs_code, '<-', sc_code)[0]
+            for et in et_vals])
+
+    A23 = derlt(sc_code, etsc_vals, rs_code, et_vals)
+    B3 = derpt(et_vals, rs_code)
+    B2 = derpt(etsc_vals, sc_code)
+    temp = (B2 - B3)/(1.0 - B3)
+    y = -A23*temp + A23 + temp
+    y *= f_uso
+    RF = f_uso - y
+
+    return RF
+
+
+def spkez_batch(code, et_vals):
+    """
+    Arguments:
+        :code (*int*): NAIF ID
+        :et_vals (*np.ndarray*): Ephemeris times
 
     Returns:
-        :DLTDT2 (*float*):
+        :states (*np.ndarray*): Nx6 array of states relative to the Solar
+                        System Barycenter in the ECLIPJ2000 frame, with no
+                        aberration correction
     """
 
     ref = 'ECLIPJ2000'
     # Index for Solar System Barycenter
-    SSB = 0
+    SSB = '0'
     abcorr = 'NONE'
 
-    [S1, _lt] = spice.spkez(sc_code, etsc, ref, abcorr, SSB)
-    [S2, _lt] = spice.spkez(rs_code, et, ref, abcorr, SSB)
-    S12 = spice.vsubg(S2, S1, 6)
+    et_vals = np.atleast_1d(np.asarray(et_vals, dtype=float))
+    states, _lt = spice.spkezr(str(code), et_vals, ref, abcorr, SSB)
 
-    R1 = spice.vnorm(S1[0:3])
-    R2 = spice.vnorm(S2[0:3])
-    R12 = spice.vnorm(S12[0:3])
+    return np.reshape(np.asarray(states, dtype=float), (-1, 6))
 
-    US1 = spice.vhat(S1[0:3])
-    US2 = spice.vhat(S2[0:3])
-    US12 = spice.vhat(S12[0:3])
 
-    DR1DT1 = spice.vdot(US1, S1[3:6])
-    DR2DT2 = spice.vdot(US2, S2[3:6])
+def derlt(sc_code, etsc, rs_code, et):
+    """
+    Arguments:
+        :sc_code (*int*): Spacecraft NAIF ID
+        :etsc (*float* or *np.ndarray*): Epoch (in ephemeris seconds past
+                        J2000 TDB) at which the signal leaves the
+                        spacecraft
+        :rs_code (*int*): Receiving station NAIF ID
+        :et (*float* or *np.ndarray*): Ephemeris time at which the signal
+                        arrives at the receiver station
+
+    Returns:
+        :DLTDT2 (*np.ndarray*): Derivative of light time with respect to
+                        receive time
+    """
 
-    PR12T2 = spice.vdot(US12, S2[3:6])
-    PR12T1 = -spice.vdot(US12, S1[3:6])
+    S1 = spkez_batch(sc_code, etsc)
+    S2 = spkez_batch(rs_code, et)
+    S12 = S2 - S1
+
+    R1 = np.linalg.norm(S1[:, 0:3], axis=1)
+    R2 = np.linalg.norm(S2[:, 0:3], axis=1)
+    R12 = np.linalg.norm(S12[:, 0:3], axis=1)
+
+    US1 = S1[:, 0:3]/R1[:, np.newaxis]
+    US2 = S2[:, 0:3]/R2[:, np.newaxis]
+    US12 = S12[:, 0:3]/R12[:, np.newaxis]
+
+    DR1DT1 = np.sum(US1*S1[:, 3:6], axis=1)
+    DR2DT2 = np.sum(US2*S2[:, 3:6], axis=1)
+
+    PR12T2 = np.sum(US12*S2[:, 3:6], axis=1)
+    PR12T1 = -np.sum(US12*S1[:, 3:6], axis=1)
 
     D1 = R1 + R2 + R12
     D2 = R1 + R2 - R12
@@ -158,29 +244,23 @@ def derlt(sc_code, etsc, rs_code, et):
 def derpt(et, code):
     """
     Arguments:
-        :et (*float*): Ephemeris time
+        :et (*float* or *np.ndarray*): Ephemeris time
         :code (*int*): NAIF ID
 
     Returns:
-        :B (*float*):
+        :B (*np.ndarray*):
     """
 
-    ref = 'ECLIPJ2000'
-    # Index for Solar System Barycenter
-    SSB = 0
-    abcorr = 'NONE'
-
-    [SI, _lt] = spice.spkez(code, et, ref, abcorr, SSB)
-    SIDOT2 = np.sum(SI[3:6]**2)
+    SI = spkez_batch(code, et)
+    SIDOT2 = np.sum(SI[:, 3:6]**2, axis=1)
 
-    PHII = 0.0
+    PHII = np.zeros(len(SI))
 
     for i in range(len(ID_SSB)):
         body = ID_SSB[i]
-        # ith body's ephemerides with respect to barycenter
-        [SJ, _lt] = spice.spkez(body, et, ref, abcorr, SSB)
-        SIJ = spice.vsubg(SJ, SI, 6)
-        RIJ = spice.vnorm(SIJ[0:3])
+        # ith body's ephemerides with respect to barycenter, at all times
+        SJ = spkez_batch(body, et)
+        RIJ = np.linalg.norm(SJ[:, 0:3] - SI[:, 0:3], axis=1)
         # potential of Barycenter
         PHII += GM_SSB[i]/RIJ
 
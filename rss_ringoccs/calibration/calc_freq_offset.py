@@ -1,5 +1,7 @@
 import numpy as np
 import sys
+from ..tools import instrument
+from .signal_spectra import SignalSpectra
 
 """
 Purpose:
@@ -24,12 +26,29 @@ class calc_freq_offset(object):
         Keyword Arguments:
             :dt_freq (*float*): half the width of the FFT window,
                         default is 64 sec
+            :method (*str*): how the FFT peak is refined. 'direct'
+                        evaluates the continuous FT at each trial
+                        frequency, one window at a time. 'czt' computes
+                        the same trial frequencies with a chirp-Z
+                        transform, for batches of windows at once.
+                        Default is 'direct'
+            :interp (*bool*): if True, refine the peak of the trial
+                        frequencies further by fitting a parabola to
+                        the log power at the peak and its neighbors.
+                        Default is False
     """
-    def __init__(self,rsr_inst,spm_min,spm_max,dt_freq=2.):
+    def __init__(self,rsr_inst,spm_min,spm_max,dt_freq=2.,method='direct',
+            interp=False):
+
+        if method not in ['direct','czt']:
+            raise ValueError("ERROR (calc_freq_offset): method must be "
+                + "'direct' or 'czt'")
 
         # Get raw SPM and raw I & Q from RSR instance
         self.spm_vals = rsr_inst.spm_vals
         self.IQ_m = rsr_inst.IQ_m
+        # windowed spectra of the raw signal, shared with calc_tau_thresh
+        self.spectra = SignalSpectra.of(rsr_inst)
         # raw SPM sampling rate in seconds
         self.dt = self.spm_vals[1]-self.spm_vals[0]
 
@@ -38,11 +57,14 @@ class calc_freq_offset(object):
         # set lower and upper limits to sampling
         self.spm_min = spm_min
         self.spm_max = spm_max
+        self.method = method
+        self.interp = interp
 
         # finds offset frequencies
         self.__find_offset_freqs()
 
 
+    @instrument.timed('calibration.calc_freq_offset')
     def __find_offset_freqs(self):
         """
         Purpose:
@@ -52,33 +74,44 @@ class calc_freq_offset(object):
         # hard-set the spacing to 10 spm between each window center
         delta_t_cent = 25.
 
-        # storage lists -- later converted to arrays and stored as attributes
-        spms = []
-        freqs = []
-        # iteratively compute peak frequency
-        for spm_mid in np.arange(self.spm_min,self.spm_max+delta_t_cent,
-                delta_t_cent):
-            # set indices using boolean mask over a range of SPM
-            ind = [(self.spm_vals>=spm_mid-self.dt_freq)&
-                    (self.spm_vals<spm_mid+self.dt_freq)]
-            # make sure data are included in range
-            if len(self.spm_vals[ind]) > 2 :
-                # get average SPM in window
-                spms += [spm_mid]
-                # get frequency of peak in power spectrum
-                freqs += [self.__find_peak_freq(self.spm_vals[ind],
-                                                self.IQ_m[ind])]
+        # windows with data in range, and the frequency of the peak of
+        #   the FFT power of each
+        spms, win_start, win_size = self.spectra.windows(
+                np.arange(self.spm_min,self.spm_max+delta_t_cent,
+                delta_t_cent),half_width=self.dt_freq)
+        f_fft = self.spectra.peak_freqs(win_start,win_size)
+
+        freqs = np.zeros(len(spms))
+        if self.method == 'czt':
+            # windows of equal length are transformed together
+            for n_pts in np.unique(win_size):
+                rows = np.where(win_size == n_pts)[0]
+                freqs[rows] = self.__find_peak_freqs_czt(win_start[rows],
+                                                         n_pts,f_fft[rows])
+        else:
+            # refine the peak of each window
+            for k in range(len(spms)):
+                i0 = win_start[k]
+                i1 = i0 + win_size[k]
+                freqs[k] = self.__find_peak_freq(self.spm_vals[i0:i1],
+                        self.IQ_m[i0:i1].copy(),f_fft[k])
+
+        instrument.count('calibration.freq_offset_windows', len(spms))
+
         # convert to arrays and store as attributes
         self.f_spm = np.array(spms)
         self.f_offset = np.array(freqs)
 
-    def __find_peak_freq(self,time,IQ,df=0.001,hwid=0.2):
+    def __find_peak_freq(self,time,IQ,f_max,df=0.001,hwid=0.2):
         """
         Purpose:
             Computes continuous FFT, finds frequency at max power
 
         Arguments:
+            :time (*np.ndarray*): SPM vals within the current window
             :IQ (*np.ndarray*): IQ_m vals within the current window
+            :f_max (*float*): frequency at max power of the FFT of
+                        the window, from ``SignalSpectra.peak_freqs``
 
         Returns:
             :f_max (*float*): frequency at max power
@@ -88,15 +121,6 @@ class calc_freq_offset(object):
                     np.arange(float(len(IQ))) / (float(len(IQ)) - 1)))
         IQ *= weight
 
-        # Get FFT frequencies
-        f = np.fft.fftfreq(IQ.size,d=self.dt)
-        # Compute FFT
-        IQ_fft = np.fft.fft(IQ)
-        # Compute power
-        power = (np.absolute(IQ_fft) ** 2) / (float(len(IQ)) ** 2)
-        # Find frequency of max power
-        f_max = f[np.argmax(power)]
-
         ### refine with continuous FT near first peak
         # frequencies within hwid Hz of peak
         freq = np.arange(f_max-hwid,f_max+hwid+df,df)
@@ -106,9 +130,104 @@ class calc_freq_offset(object):
         power = (np.absolute(IQ_fft) ** 2) / (float(len(IQ)) ** 2)
         # Find frequency of max power
         #if abs(f_max - freq[np.argmax(power)]) < hwid:
-        f_max = freq[np.argmax(power)]
+        i_max = np.argmax(power)
+        f_max = freq[i_max]
+        if self.interp:
+            f_max += df*self.__parabolic_offset(power[None,:],
+                                                np.array([i_max]))[0]
+
+        return f_max
+
+    def __find_peak_freqs_czt(self,starts,n_pts,f_fft,df=0.001,hwid=0.2):
+        """
+        Purpose:
+            Same as __find_peak_freq, for several windows of n_pts
+            points at once. The continuous FT at the trial frequencies
+            is computed with a chirp-Z transform (Bluestein's algorithm)
+            in O(N log N) operations per window, rather than one sum
+            over the window per trial frequency.
+
+        Arguments:
+            :starts (*np.ndarray*): index of the first point of each
+                        window in IQ_m
+            :n_pts (*int*): number of points in every window
+            :f_fft (*np.ndarray*): frequency at max power of the FFT of
+                        each window, from ``SignalSpectra.peak_freqs``
+
+        Returns:
+            :f_max (*np.ndarray*): frequency at max power of each window
+        """
+        n_win = len(starts)
+        n_freq = int(round(2.0*hwid/df)) + 1
+        n = np.arange(n_pts)
+        k = np.arange(n_freq)
+
+        # Same window as __find_peak_freq
+        weight = 0.5 * (1.0 - np.cos(2.0 * np.pi * n / (float(n_pts) - 1)))
+
+        # Chirp shared by every window. With W = exp(-2j*pi*dt*df),
+        #   X_k = W^(k^2/2) * sum_n (y_n W^(n^2/2)) W^(-(k-n)^2/2),
+        #   and only |X_k| is needed, so the leading phase factors of both
+        #   the chirp and the window start time are dropped
+        nfft = int(2**np.ceil(np.log2(n_pts+n_freq-1)))
+        chirp_n = np.exp(-1j*np.pi*self.dt*df*n.astype(float)**2)
+        m = np.arange(-(n_pts-1),n_freq)
+        h = np.zeros(nfft,dtype=complex)
+        h[:len(m)] = np.exp(1j*np.pi*self.dt*df*m.astype(float)**2)
+        h_fft = np.fft.fft(h)
+
+        # Transform windows in batches to bound the memory used
+        n_batch = max(1,4194304//nfft)
+        f_max = np.zeros(n_win)
+        for b0 in range(0,n_win,n_batch):
+            rows = starts[b0:b0+n_batch]
+            IQ = self.IQ_m[rows[:,None] + n[None,:]] * weight[None,:]
+
+            # Start from the coarse peak of the FFT of each window
+            f0 = f_fft[b0:b0+n_batch] - hwid
+
+            # Shift each window down by its own start frequency
+            y = IQ * np.exp(-2j*np.pi*self.dt*np.outer(f0,n)) * chirp_n
+            y_fft = np.fft.fft(y,n=nfft,axis=1)
+            X = np.fft.ifft(y_fft*h_fft[None,:],axis=1)
+            X = X[:,n_pts-1:n_pts-1+n_freq]
+
+            power = (np.absolute(X) ** 2) / (float(n_pts) ** 2)
+            i_max = np.argmax(power,axis=1)
+            f_peak = f0 + k[i_max]*df
+            if self.interp:
+                f_peak += df*self.__parabolic_offset(power,i_max)
+            f_max[b0:b0+n_batch] = f_peak
 
         return f_max
+
+    def __parabolic_offset(self,power,i_max):
+        """
+        Purpose:
+            Offset of the true peak from the sampled peak, in units of
+            the frequency spacing, from a parabola through the log power
+            at the peak and its two neighbors. Peaks at either end of the
+            trial frequencies are not moved.
+
+        Arguments:
+            :power (*np.ndarray*): 2-D array of power, one row per window
+            :i_max (*np.ndarray*): index of the max power in each row
+
+        Returns:
+            :delta (*np.ndarray*): offsets, between -0.5 and 0.5
+        """
+        delta = np.zeros(len(i_max))
+        inner = (i_max > 0) & (i_max < power.shape[1]-1)
+        rows = np.where(inner)[0]
+        i = i_max[inner]
+        tiny = np.finfo(float).tiny
+        pm = np.log(power[rows,i-1]+tiny)
+        p0 = np.log(power[rows,i]+tiny)
+        pp = np.log(power[rows,i+1]+tiny)
+        denom = pm - 2.0*p0 + pp
+        good = denom < 0
+        delta[rows[good]] = 0.5*(pm[good]-pp[good])/denom[good]
+        return delta
 """
 Revisions
 """
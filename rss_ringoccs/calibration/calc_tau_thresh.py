@@ -20,7 +20,7 @@ Purpose:
 import numpy as np
 import matplotlib.pyplot as plt
 from scipy.interpolate import splrep,splev
-from scipy.signal import spectrogram
+from .signal_spectra import SignalSpectra
 
 class calc_tau_thresh(object):
     """
@@ -68,8 +68,10 @@ class calc_tau_thresh(object):
         self.spm_vals = cal_inst.t_oet_spm_vals
         self.rho_vals = rho_km
 
-        # find noise power
-        noise = self.find_noise(rsr_inst.spm_vals,rsr_inst.IQ_m,df)
+        # find noise power, from the windowed spectra of the raw signal
+        #   shared with calc_freq_offset
+        noise = self.find_noise(rsr_inst.spm_vals,rsr_inst.IQ_m,df,
+                spectra=SignalSpectra.of(rsr_inst))
 
         # find signal power
         signal = cal_inst.p_free_vals
@@ -85,35 +87,46 @@ class calc_tau_thresh(object):
         # compute threshold optical depth
         self.tau_thresh = tau
 
-    def find_noise(self,spm,IQ,df):
+    def find_noise(self,spm,IQ,df,spectra=None):
         """
         Purpose:
             Locate the additive receiver noise within the data set.
-            This is done by computing a spectrogram of the raw
-            complex signal, filtering out the spacecraft signal, and
-            averaging over the frequency and time domains.
+            This is done by computing windowed spectra of the raw
+            complex signal before and after the occultation,
+            filtering out the spacecraft signal, and averaging over
+            the frequency and time domains.
 
         Arguments:
             :spm (*np.ndarray*): raw SPM in seconds
             :IQ (*np.ndarray*): measured complex signal
             :df (*float*): sampling frequency in Hz of the IQ
 
+        Keyword Arguments:
+            :spectra (*object*): instance of SignalSpectra of the same
+                        signal, whose windows are reused. If None,
+                        new spectra are computed
+
         Returns:
             :p_noise (*np.ndarray*): noise power
         """
-        # Spectrogram to filter out spacecraft signal
-        n = int(1.024 * df) # number of elements based on frequency sampling
-        freq,time,Sxx = spectrogram(IQ,df,nperseg=n,return_onesided=False)
-        time += spm[0]
-        # frequency filtering to include only the thermal receiver power, 
-        #   averaged over time
-        Sxx_freq_filt = np.nanmean(Sxx[((freq>-450)&(freq<-200))|
-            ((freq>200)&(freq<450)),:],0)
+        if spectra is None:
+            spectra = SignalSpectra(spm,IQ)
+
         # time filtering to include only the signal outside the occultation
-        # by looking at just the first and last 1,000 seconds
+        # by looking at just the first and last 1,000 seconds, with Hann
+        # windows that overlap by at least half, as in Welch's method, so
+        # that every sample is weighted about equally
         tmin = spm[0]+1e3
         tmax = spm[-1]-1e3
-        p_noise = np.nanmean(Sxx_freq_filt[(time<tmin)|(time>tmax)])
+        n_sub = int(np.ceil(spectra.step/spectra.half_width))
+        spm_mids = np.hstack((
+                spectra.grid_mids(spm[0],min(tmin,spm[-1]),n_sub=n_sub),
+                spectra.grid_mids(max(tmax,spm[0]),spm[-1],n_sub=n_sub)))
+        spm_mids, starts, n_pts = spectra.windows(np.unique(spm_mids))
+
+        # frequency filtering to include only the thermal receiver power,
+        #   as a power spectral density averaged over time
+        p_noise = np.nanmean(spectra.band_power(starts,n_pts)) / df
 
         return p_noise
 """
@@ -47,6 +47,11 @@ class Calibration(object):
         :fof_order (*float*): Whole number specifying the polynomial
                         order to use when fitting the frequency offset
                         residual. Default is 9.
+        :freq_method (*str*): Method used to refine the peak frequency
+                        of each FFT window, 'direct' or 'czt'. 'czt'
+                        computes the same trial frequencies with a
+                        chirp-Z transform, and is much faster for 16 kHz
+                        data. Default is 'direct'.
         :pnf_order (*float*): whole number specifying the polynomial
                         order to use when fitting the freespace power.
                         Default is 3.
@@ -94,7 +99,7 @@ class Calibration(object):
 
     def __init__(self, rsr_inst, geo_inst, fof_order=9, pnf_order=3, dt_cal=1.0,
                  verbose=False, write_file=True, interact=False,
-                 pnf_fittype='poly'):
+                 pnf_fittype='poly', freq_method='direct'):
 
         if not isinstance(geo_inst, Geometry):
             sys.exit('ERROR (Calibration): geo_inst input needs to be an '
@@ -122,7 +127,8 @@ class Calibration(object):
         # Calculate frequency offset fit
         # Use default residual frequency fit
         fit_inst = FreqOffsetFit(rsr_inst, geo_inst, verbose=verbose,
-                poly_order=fof_order, write_file=write_file)
+                poly_order=fof_order, freq_method=freq_method,
+                write_file=write_file)
 
         # Get corrected I's and Q's
         self.IQ_c = self.correct_IQ(rsr_inst.spm_vals,rsr_inst.IQ_m,
@@ -176,7 +182,8 @@ class Calibration(object):
                 "dt_cal": dt_cal,
                 "pnf_fittype": pnf_fittype,
                 "freespace_spm": gaps_used,
-                "interact": interact}
+                "interact": interact,
+                "freq_method": freq_method}
 
         additional_info = {
                 "FORFIT_chi_squared": self.FORFIT_chi_squared,
@@ -191,7 +198,7 @@ class Calibration(object):
             write_output_files(self)
 
 
-    def correct_IQ(self,spm_vals,IQ_m,f_spm,f_offset_fit):
+    def correct_IQ(self,spm_vals,IQ_m,f_spm,f_offset_fit,block_size=65536):
         """
         Purpose:
 
@@ -215,6 +222,10 @@ class Calibration(object):
 
             as discussed in [CRSUG2018]_ (see their Equation 17).
 
+            The phase spline is evaluated and applied one block of
+            samples at a time, writing into the output array, so the
+            only full-length array allocated is ``IQ_c`` itself.
+
         Arguments:
             :spm_vals (*np.ndarray*): raw SPM values
             :IQ_m (*np.ndarray*): raw complex signal measured by DSN
@@ -224,6 +235,10 @@ class Calibration(object):
             :f_offset_fit (*np.ndarray*): frequency of the spacecraft
                         signal corresponding to ``f_spm``
 
+        Keyword Arguments:
+            :block_size (*int*): number of samples detrended per block.
+                        Default is 65536.
+
         Returns:
             :IQ_c (*np.ndarray*): Frequency-corrected complex signal
                         :math:`I_{c}+iQ_{c}` corresponding to
@@ -243,10 +258,17 @@ class Calibration(object):
         f_detrend_interp = np.cumsum(f_offset_fit_interp) * dt
         f_detrend_interp_rad = f_detrend_interp * (2.0 * np.pi)
         f_detrend_rad_splcoef = splrep(f_spm_interp, f_detrend_interp_rad)
-        f_detrend_rad = splev(spm_vals, f_detrend_rad_splcoef)
 
-        # Apply detrending function
-        IQ_c = IQ_m * np.exp(-1j * f_detrend_rad)
+        # Evaluate the detrending function and apply it block by block,
+        # so the phase and rotation temporaries are only block_size long
+        n_pts = len(spm_vals)
+        block_size = max(int(block_size), 1)
+        IQ_c = np.empty(n_pts, dtype=np.result_type(IQ_m, np.complex128))
+        for i0 in range(0, n_pts, block_size):
+            i1 = min(i0 + block_size, n_pts)
+            f_detrend_rad = splev(spm_vals[i0:i1], f_detrend_rad_splcoef)
+            rot = np.exp(-1j * f_detrend_rad)
+            np.multiply(IQ_m[i0:i1], rot, out=IQ_c[i0:i1])
 
         return IQ_c
 """
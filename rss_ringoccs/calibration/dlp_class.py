@@ -9,13 +9,14 @@ Purpose:
 
 import copy
 import numpy as np
-from scipy.interpolate import splrep, splev, interp1d
+from scipy.interpolate import splrep, splev, interp1d, make_interp_spline
 
 from ..rsr_reader.rsr_reader import RSRReader
 from .resample_IQ import resample_IQ
 from .calc_tau_thresh import calc_tau_thresh
 from ..tools.history import write_history_dict
 from ..tools.write_output_files import write_output_files
+from ..tools import instrument
 
 class DiffractionLimitedProfile(object):
     """
@@ -183,6 +184,7 @@ class DiffractionLimitedProfile(object):
 
 
 
+    @instrument.timed('calibration.dlp_interp_and_set_attr')
     def __interp_and_set_attr(self, rho_km_desired, spm_desired,
             p_norm_vals, spm_cal, phase_rad_vals, spm_geo, rho_dot_kms_geo,
             B_deg_vals, F_km_geo, t_ret_geo, t_set_geo,
@@ -193,9 +195,16 @@ class DiffractionLimitedProfile(object):
         phi_ora_rad_geo = np.radians(phi_ora_deg_vals)
         phi_rl_rad_geo = np.radians(phi_rl_deg_vals)
 
-        # ring longitude at final spacing
-        spm_to_rhodot = splrep(spm_geo, rho_dot_kms_geo)
-        rho_dot_kms_vals_interp = splev(spm_desired, spm_to_rhodot)
+        # All geometry quantities share the spm_geo abscissa, and hence the
+        #   knots of the interpolating spline, so fit them as one spline
+        #   with a column per quantity and evaluate them in a single pass
+        geo_vals = np.stack((rho_dot_kms_geo, B_rad_geo, D_km_geo, F_km_geo,
+            phi_ora_rad_geo, phi_rl_rad_geo, t_ret_geo, t_set_geo), axis=-1)
+        spm_to_geo = make_interp_spline(spm_geo, geo_vals, k=3)
+        geo_vals_interp = spm_to_geo(spm_desired)
+
+        # ring intercept radial velocity at final spacing
+        rho_dot_kms_vals_interp = geo_vals_interp[:, 0]
 
         # check if rho_dot is both positive and negative,
         #   if so, remove unwanted values
@@ -208,40 +217,34 @@ class DiffractionLimitedProfile(object):
             rho_km_desired = np.delete(rho_km_desired, ind)
             p_norm_vals = np.delete(p_norm_vals, ind)
             phase_rad_vals = np.delete(phase_rad_vals, ind)
-            rho_dot_kms_vals_interp = splev(spm_desired, spm_to_rhodot)
+            geo_vals_interp = np.delete(geo_vals_interp, ind.ravel(), axis=0)
+
+        rho_dot_kms_vals_interp = geo_vals_interp[:, 0]
 
         # ring opening angle at final spacing
-        spm_to_B = splrep(spm_geo, B_rad_geo)
-        B_rad_vals_interp = splev(spm_desired, spm_to_B)
+        B_rad_vals_interp = geo_vals_interp[:, 1]
 
         # spacecraft - rip distance at final spacing
-        spm_to_D = splrep(spm_geo, D_km_geo)
-        D_km_vals_interp = splev(spm_desired, spm_to_D)
+        D_km_vals_interp = geo_vals_interp[:, 2]
 
         # Fresnel scale at final spacing
-        spm_to_F = splrep(spm_geo, F_km_geo)
-        F_km_vals_interp = splev(spm_desired, spm_to_F)
-
-        # sky frequency at final spacing
-        spm_to_fsky = splrep(spm_cal, f_sky_pred_cal)
-        f_sky_hz_vals_interp = splev(spm_desired, spm_to_fsky)
+        F_km_vals_interp = geo_vals_interp[:, 3]
 
         # obvserved ring azimuth at final spacing
-        spm_to_phi_ora = splrep(spm_geo, phi_ora_rad_geo)
-        phi_ora_rad_vals_interp = splev(spm_desired, spm_to_phi_ora)
+        phi_ora_rad_vals_interp = geo_vals_interp[:, 4]
 
-        # obvserved ring azimuth at final spacing
-        spm_to_phi_rl = splrep(spm_geo, phi_rl_rad_geo)
-        phi_rl_rad_vals_interp = splev(spm_desired, spm_to_phi_rl)
+        # ring longitude at final spacing
+        phi_rl_rad_vals_interp = geo_vals_interp[:, 5]
 
         # ring event time at final spacing
-        spm_to_ret = splrep(spm_geo, t_ret_geo)
-        t_ret_spm_vals_interp = splev(spm_desired, spm_to_ret)
+        t_ret_spm_vals_interp = geo_vals_interp[:, 6]
 
         # spacecraft event time at final spacing
-        spm_to_set = splrep(spm_geo, t_set_geo)
-        t_set_spm_vals_interp = splev(spm_desired, spm_to_set)
+        t_set_spm_vals_interp = geo_vals_interp[:, 7]
 
+        # sky frequency at final spacing
+        spm_to_fsky = splrep(spm_cal, f_sky_pred_cal)
+        f_sky_hz_vals_interp = splev(spm_desired, spm_to_fsky)
 
         # FILLERS FOR RADIUS CORRECTION
         rho_corr_pole_km_vals = np.zeros(len(spm_desired))
@@ -267,6 +270,7 @@ class DiffractionLimitedProfile(object):
         self.tau_vals = -np.sin(B_rad_vals_interp)*np.log(p_norm_vals)
         self.raw_tau_threshold_vals = np.interp(
                 spm_desired, spm_thresh, tau_thresh)
+        instrument.count('calibration.dlp_points', len(spm_desired))
 
 
     @classmethod
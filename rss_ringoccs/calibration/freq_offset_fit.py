@@ -55,6 +55,9 @@ class FreqOffsetFit(object):
         :f_uso_x (*float*): frequency in Hz of the X-band ultra-stable
                         oscilator onboard the Cassini spacecraft.
                         Default is 8427222034.3405 Hz.
+        :freq_method (*str*): method used by ``calc_freq_offset`` to
+                        refine the FFT peak, 'direct' or 'czt'.
+                        Default is 'direct'.
         :verbose (*bool*): when True, enables verbose output mode
 
     Attributes:
@@ -79,7 +82,8 @@ class FreqOffsetFit(object):
     """
 
     def __init__(self, rsr_inst, geo_inst, poly_order=7,
-            f_uso_x=8427222034.34050, verbose=False, write_file=False):
+            f_uso_x=8427222034.34050, freq_method='direct', verbose=False,
+            write_file=False):
 
 
         # Check inputs for validity
@@ -157,7 +161,8 @@ class FreqOffsetFit(object):
         if verbose:
             print('\tCalculating observed frequency offset...')
 
-        foff_inst = calc_freq_offset(rsr_inst,spm_min,spm_max)
+        foff_inst = calc_freq_offset(rsr_inst,spm_min,spm_max,
+                method=freq_method)
         f_spm, f_offset = foff_inst.f_spm, foff_inst.f_offset
 
         if verbose:
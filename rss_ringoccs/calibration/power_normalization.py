@@ -12,6 +12,7 @@ from scipy.interpolate import splrep
 from scipy.interpolate import splev
 
 from ..tools.write_output_files import construct_filepath
+from ..tools import instrument
 import matplotlib.pyplot as plt
 from matplotlib.gridspec import GridSpec
 
@@ -49,6 +50,7 @@ class Normalization(object):
                         to the freespace power. Default is False.
     """
 
+    @instrument.timed('calibration.Normalization')
     def __init__(self, spm_raw, IQ_c, geo_inst, rsr_inst, order=3,
             fittype='poly', interact=False, verbose=False,
             write_file=False):
@@ -69,6 +71,7 @@ class Normalization(object):
         # downsample IQ so that diffraction fringes do not affect fit
         spm_down, p_obs_down = self.downsample_IQ(spm_raw, IQ_c,dt_down=0.2)
         self.spm_down = spm_down
+        instrument.count('calibration.normalization_points', len(spm_raw))
 
         #rho_down = splev(spm_down, spm_to_rho)
         spm_to_rho = splrep(geo_inst.t_oet_spm_vals, geo_inst.rho_km_vals)
@@ -7,8 +7,48 @@ Purpose:
 """
 
 import numpy as np
-from scipy import signal
 from scipy.interpolate import interp1d
+from ..rsr_reader.polyphase import PolyphaseDecimator
+from ..tools import instrument
+
+# Filter parameters of scipy.signal.resample_poly, used so that the
+#     polyphase decimator gives the same output
+RESAMPLE_N_HALF = 10
+RESAMPLE_BETA = 5.0
+
+
+def uniform_grid(rho_km, freq):
+    """
+    Purpose:
+        Compute the uniform radius grid, at a spacing comparable to that
+        of raw resolution, onto which the signal is interpolated before
+        downsampling.
+
+    Arguments:
+        :rho_km (*np.ndarray*): radius in kilometers
+        :freq (*float*): radial sampling frequency
+
+    Returns:
+        :r0 (*float*): first radius of the grid
+        :dr_grid (*float*): spacing of the grid
+        :n_pts (*int*): number of points in the grid
+        :p (*float*): upsampling rate. This will always be unity because
+                 no upsampling is done.
+        :q (*float*): downsampling rate from the grid to the final
+                 spacing 1/freq
+    """
+    # initial radius and radial range
+    r0 = round(rho_km[0])
+    dr = abs(rho_km[-1] - r0)
+
+    # Average radius spacing over region
+    ts_avg = dr / float(len(rho_km) - 1)
+    p = 1
+    q = int(round(1.0 / (ts_avg * freq)))
+    dr_grid = float(p) / (q * freq)
+    n_pts = int(round(dr / dr_grid))
+
+    return r0, dr_grid, n_pts, p, q
 
 
 def pre_resample(rho_km, vec, freq):
@@ -38,19 +78,10 @@ def pre_resample(rho_km, vec, freq):
                   sampled.
 
     """
-    # initial radius and radial range
-    r0 = round(rho_km[0])
-    dr = abs(rho_km[-1] - r0)
-
-    # Average radius spacing over region
-    ts_avg = dr / float(len(rho_km) - 1)
-    p = 1
-    q = int(round(1.0 / (ts_avg * freq)))
-    dr_grid = float(p) / (q * freq)
+    r0, dr_grid, n_pts, p, q = uniform_grid(rho_km, freq)
 
     # Uniform radius grid at near-raw resolution to which to interpolate.
     #     For ingress, this implicitly reverses radius scale!
-    n_pts = round(dr / dr_grid)
     rho_grid = r0 + dr_grid * np.arange(n_pts)
 
     # Interpolate to near-raw resolution. For ingress, this implicitly
@@ -62,7 +93,34 @@ def pre_resample(rho_km, vec, freq):
     return rho_grid, vec_grid, p, q
 
 
-def resample_IQ(rho_km, IQ_c, dr_desired, verbose=False):
+def interp_linear(rho_km, IQ, rho_grid):
+    """
+    Purpose:
+        Linearly interpolate a complex signal, extrapolating from the
+        first and last intervals outside of rho_km. This is the same
+        computation as ``interp1d(kind='linear', fill_value='extrapolate')``
+        applied to I and Q separately.
+
+    Arguments:
+        :rho_km (*np.ndarray*): increasing radius in kilometers
+        :IQ (*np.ndarray*): complex signal sampled at rho_km
+        :rho_grid (*np.ndarray*): radii at which to interpolate
+
+    Returns:
+        :IQ_grid (*np.ndarray*): complex signal at rho_grid
+    """
+    ind_hi = np.clip(np.searchsorted(rho_km, rho_grid), 1, len(rho_km) - 1)
+    ind_lo = ind_hi - 1
+
+    rho_lo = rho_km[ind_lo]
+    IQ_lo = IQ[ind_lo]
+    slope = (IQ[ind_hi] - IQ_lo) / (rho_km[ind_hi] - rho_lo)
+
+    return slope * (rho_grid - rho_lo) + IQ_lo
+
+
+@instrument.timed('calibration.resample_IQ')
+def resample_IQ(rho_km, IQ_c, dr_desired, verbose=False, block_size=1048576):
     """
     Purpose:
         Resample I and Q to uniformly spaced radius. Based off of
@@ -80,10 +138,20 @@ def resample_IQ(rho_km, IQ_c, dr_desired, verbose=False):
         :verbose (*bool*):
             Testing variable to print out the first few resampled
             results
+        :block_size (*int*):
+            Number of points of the uniform radius grid interpolated and
+            filtered at a time. The full grid is never held in memory.
+            Default is 1048576.
     Returns:
         :rho_km_desired (*np.ndarray*): array of ring radius at final desired
                 spacing
         :IQ_c_desired (*np.ndarray*):
+
+    Notes:
+        #. I and Q are interpolated together as one complex signal, and
+           downsampled with the same filter and time alignment as
+           ``scipy.signal.resample_poly``, using a cached polyphase filter
+           that carries its state from one block to the next.
     """
 
     rho_km_diff = np.diff(rho_km)
@@ -104,23 +172,36 @@ def resample_IQ(rho_km, IQ_c, dr_desired, verbose=False):
         rho_km = rho_km[::-1]
         IQ_c = IQ_c[::-1]
 
-    I_c = np.real(IQ_c)
-    Q_c = np.imag(IQ_c)
-
-    # Pre-resampling steps. Interpolates to uniform radius at near-raw spacing
-    rho_km_uniform, I_c_uniform, p, q = pre_resample(rho_km, I_c,
-        1.0 / dr_desired)
-    rho_km_uniform, Q_c_uniform, p, q = pre_resample(rho_km, Q_c,
-        1.0 / dr_desired)
-
-    # Downsample by factor q to desired final spacing
-    I_c_desired = signal.resample_poly(I_c_uniform, p, q)
-    Q_c_desired = signal.resample_poly(Q_c_uniform, p, q)
-
-    rho_km_desired = (rho_km_uniform[0]
-        + dr_desired * np.arange(len(I_c_desired)))
+    # Uniform radius grid at near-raw resolution, computed once for I and Q
+    r0, dr_grid, n_pts, p, q = uniform_grid(rho_km, 1.0 / dr_desired)
+
+    # Interpolate to the grid and downsample by factor q to desired final
+    #     spacing, one block of the grid at a time
+    #     (as with resample_poly, nothing is filtered if q is 1)
+    if q > 1:
+        decimator = PolyphaseDecimator(q, n_half=RESAMPLE_N_HALF,
+            beta=RESAMPLE_BETA, dtype=np.complex128)
+    else:
+        decimator = None
+    IQ_c_desired = []
+    block_size = max(int(block_size), 1)
+    for i0 in range(0, n_pts, block_size):
+        rho_grid = r0 + dr_grid * np.arange(i0, min(i0 + block_size, n_pts))
+        IQ_grid = interp_linear(rho_km, IQ_c, rho_grid)
+        if decimator is None:
+            IQ_c_desired.append(IQ_grid)
+        else:
+            IQ_c_desired.append(decimator.process(IQ_grid))
+    if decimator is not None:
+        IQ_c_desired.append(decimator.flush())
+    IQ_c_desired = np.hstack(IQ_c_desired)
+
+    rho_km_desired = (r0 + dr_desired * np.arange(len(IQ_c_desired)))
+
+    instrument.count('calibration.resample_points_in', len(rho_km))
+    instrument.count('calibration.resample_grid_points', n_pts)
+    instrument.count('calibration.resample_points_out', len(IQ_c_desired))
 
-    IQ_c_desired = I_c_desired + 1j * Q_c_desired
     return rho_km_desired, IQ_c_desired
 
 """
@@ -0,0 +1,221 @@
+"""
+Purpose:
+    Short-time spectra of the raw measured signal, shared by the
+    calibration stages that need them. The frequency offset
+    (``calc_freq_offset``) needs the peak of the spectrum of windows
+    spaced through the occultation. The thermal noise used for the
+    threshold optical depth (``calc_tau_thresh``) needs the power in
+    bands away from the spacecraft signal, before and after the
+    occultation. Both are taken from the same Hann-windowed FFT of a
+    window. Each window is transformed once, in batches of windows of
+    equal length to bound the memory used, and only its spectral peak
+    and band power are kept, so no spectrogram of the full data set is
+    ever held in memory.
+
+Dependencies:
+    #. numpy
+"""
+import numpy as np
+from ..tools import instrument
+
+# Frequency bands of the thermal receiver noise, in Hz, either side of
+#   the spacecraft signal
+NOISE_BANDS_HZ = [[-450., -200.], [200., 450.]]
+
+class SignalSpectra(object):
+    """
+    Purpose:
+        Spectral peak and noise band power of windows of the raw signal.
+        Results are kept for every window transformed, so a window
+        requested by two stages is only transformed once.
+
+    Arguments:
+        :spm_vals (*np.ndarray*): raw SPM in seconds, sorted
+        :IQ_m (*np.ndarray*): raw measured complex signal
+
+    Keyword Arguments:
+        :half_width (*float*): half the width of a window in seconds.
+                        Default is 2, as for ``calc_freq_offset``
+        :step (*float*): spacing in seconds of the grid of the first
+                        windows requested, as used by
+                        ``calc_freq_offset``. The windows of the noise
+                        estimate are placed on a finer grid that
+                        contains it, so that they are shared where the
+                        ranges of both stages overlap. Default is 25
+
+    Attributes:
+        :dt (*float*): raw SPM sampling in seconds
+        :n_computed (*int*): number of windows transformed
+        :n_reused (*int*): number of windows requested again
+    """
+    def __init__(self,spm_vals,IQ_m,half_width=2.,step=25.):
+        self.spm_vals = spm_vals
+        self.IQ_m = IQ_m
+        self.dt = spm_vals[1]-spm_vals[0]
+        self.half_width = half_width
+        self.step = step
+        self.n_computed = 0
+        self.n_reused = 0
+
+        # Window (first index, length): (peak frequency, band power)
+        self.__stats = {}
+        self.__origin = None
+
+    @classmethod
+    def of(cls,rsr_inst):
+        """
+        Purpose:
+            Spectra of the raw signal of an RSRReader instance, made on
+            first use and kept with the instance. They are made again if
+            the signal of the instance has been replaced, as when
+            ``DiffractionLimitedProfile.create_dlps`` trims a chord
+            occultation.
+
+        Arguments:
+            :rsr_inst (*object*): object instance of the RSRReader class
+
+        Returns:
+            :spectra (*object*): instance of SignalSpectra
+        """
+        spectra = getattr(rsr_inst,'signal_spectra',None)
+        if (spectra is None or spectra.spm_vals is not rsr_inst.spm_vals
+                or spectra.IQ_m is not rsr_inst.IQ_m):
+            spectra = cls(rsr_inst.spm_vals,rsr_inst.IQ_m)
+            rsr_inst.signal_spectra = spectra
+        return spectra
+
+    def windows(self,spm_mids,half_width=None):
+        """
+        Purpose:
+            Locate the windows centered on the given times. Windows with
+            fewer than three points are dropped.
+
+        Arguments:
+            :spm_mids (*np.ndarray*): window centers in SPM
+
+        Keyword Arguments:
+            :half_width (*float*): half the width of the windows in
+                        seconds. Default is the half_width of the
+                        instance
+
+        Returns:
+            :spm_mids (*np.ndarray*): centers of the windows kept
+            :starts (*np.ndarray*): index of the first point of each
+                        window in IQ_m
+            :n_pts (*np.ndarray*): number of points in each window
+        """
+        if half_width is None:
+            half_width = self.half_width
+        spm_mids = np.asarray(spm_mids,dtype=float)
+        if (self.__origin is None) and (len(spm_mids) > 0):
+            self.__origin = spm_mids[0]
+
+        # the SPM values are sorted, so each window is a contiguous slice
+        i0 = np.searchsorted(self.spm_vals,spm_mids-half_width,'left')
+        i1 = np.searchsorted(self.spm_vals,spm_mids+half_width,'left')
+        keep = (i1-i0) > 2
+        return spm_mids[keep], i0[keep], (i1-i0)[keep]
+
+    def grid_mids(self,spm_min,spm_max,n_sub=1):
+        """
+        Purpose:
+            Centers of the windows that lie within a time range, on the
+            grid of the windows requested so far.
+
+        Arguments:
+            :spm_min (*float*): start of the range in SPM
+            :spm_max (*float*): end of the range in SPM
+
+        Keyword Arguments:
+            :n_sub (*int*): number of windows per step of the grid, so
+                        that the spacing is step/n_sub. Default is 1
+
+        Returns:
+            :spm_mids (*np.ndarray*): window centers in SPM
+        """
+        if self.__origin is None:
+            origin = self.spm_vals[0] + self.half_width
+        else:
+            origin = self.__origin
+        step = self.step/n_sub
+        k0 = np.ceil((spm_min+self.half_width-origin)/step)
+        k1 = np.floor((spm_max-self.half_width-origin)/step)
+        return origin + step*np.arange(k0,k1+1)
+
+    def peak_freqs(self,starts,n_pts):
+        """
+        Purpose:
+            Frequency of the largest FFT power of each window.
+
+        Arguments:
+            :starts (*np.ndarray*): index of the first point of each
+                        window in IQ_m
+            :n_pts (*np.ndarray*): number of points in each window
+
+        Returns:
+            :f_peak (*np.ndarray*): frequency in Hz at the peak power
+        """
+        return self.__get(starts,n_pts)[0]
+
+    def band_power(self,starts,n_pts):
+        """
+        Purpose:
+            Mean power in the noise bands (NOISE_BANDS_HZ) of each
+            window, per unit of the sampling frequency, i.e. the power
+            spectral density times the sampling frequency in Hz.
+
+        Arguments:
+            :starts (*np.ndarray*): index of the first point of each
+                        window in IQ_m
+            :n_pts (*np.ndarray*): number of points in each window
+
+        Returns:
+            :p_band (*np.ndarray*): mean band power of each window
+        """
+        return self.__get(starts,n_pts)[1]
+
+    def __get(self,starts,n_pts):
+        starts = np.asarray(starts,dtype=int)
+        n_pts = np.asarray(n_pts,dtype=int)
+        todo = [k for k in range(len(starts))
+                if (starts[k],n_pts[k]) not in self.__stats]
+        self.n_reused += len(starts) - len(todo)
+        instrument.count('calibration.spectra_reused',len(starts)-len(todo))
+
+        # windows of equal length are transformed together
+        todo = np.array(todo,dtype=int)
+        for n in np.unique(n_pts[todo]):
+            rows = todo[n_pts[todo] == n]
+            self.__compute(starts[rows],n)
+
+        stats = np.array([self.__stats[(starts[k],n_pts[k])]
+                for k in range(len(starts))]).reshape(len(starts),2)
+        return stats[:,0], stats[:,1]
+
+    def __compute(self,starts,n_pts):
+        # Same window as calc_freq_offset
+        n = np.arange(n_pts)
+        weight = 0.5 * (1.0 - np.cos(2.0 * np.pi * n / (float(n_pts) - 1)))
+        f = np.fft.fftfreq(n_pts,d=self.dt)
+        band = np.zeros(n_pts,dtype=bool)
+        for f_lo,f_hi in NOISE_BANDS_HZ:
+            band |= (f > f_lo) & (f < f_hi)
+        n_band = np.count_nonzero(band)
+        w_norm = np.sum(weight*weight)
+
+        # Transform windows in batches to bound the memory used
+        n_batch = max(1,4194304//n_pts)
+        for b0 in range(0,len(starts),n_batch):
+            rows = starts[b0:b0+n_batch]
+            IQ = self.IQ_m[rows[:,None] + n[None,:]] * weight[None,:]
+            power = np.absolute(np.fft.fft(IQ,axis=1)) ** 2
+            f_peak = f[np.argmax(power,axis=1)]
+            if n_band > 0:
+                p_band = np.mean(power[:,band],axis=1) / w_norm
+            else:
+                p_band = np.zeros(len(rows)) + np.nan
+            for k in range(len(rows)):
+                self.__stats[(rows[k],n_pts)] = (f_peak[k],p_band[k])
+
+        self.n_computed += len(starts)
+        instrument.count('calibration.spectra_windows',len(starts))
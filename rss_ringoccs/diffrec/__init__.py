@@ -46,6 +46,19 @@
                     Given a requested resolution and an instance of
                     the NormDiff class (See Calibration subpackage),
                     this produces a diffraction corrected profile.
+                    DiffractionCorrection.batch computes profiles
+                    for several resolutions and window types, with
+                    the input checks and geometry done once.
+                DiffractionCorrectionBatch:
+                    Class
+                    The profiles returned by DiffractionCorrection.batch,
+                    stacked on a common radial grid.
+                DiffractionCorrectionSession:
+                    Class
+                    Returned by DiffractionCorrection.session. Keeps
+                    the reconstructed points of a data set so that
+                    reconstructing a wider range, or the same range
+                    again, only computes the points that are new.
         Special Functions:
             fresnel_sin.........The Fresnel sine integral.
             fresnel_cos.........The Fresnel cosine integral.
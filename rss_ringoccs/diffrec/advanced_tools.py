@@ -57,20 +57,21 @@ class FindOptimalResolution(object):
         rstart      = int(np.min((tr-rmin>=0).nonzero()))
         rfin        = int(np.max((rmax-tr>=0).nonzero()))
         tau_power   = tau_power[rstart:rfin+1]
+        res_vals    = sres + dres*np.arange(nres)
+        batch       = DiffractionCorrection.batch(data, res_vals, wtypes=wlst,
+                                                  rng=rng)
         for i in np.arange(nres):
             for j in range(nwins):
                 wtype = wlst[j]
-                recint = DiffractionCorrection(data, res, rng=rng,
-                                               wtype=wtype)
+                recint = batch.profiles[j][i]
                 p_int = recint.power_vals
                 linf = np.max(np.abs(p_int - tau_power))
                 l2 = np.sqrt(np.sum(np.abs(p_int-tau_power)**2)*recint.dx_km)
                 linfint[j,i] = linf
                 l2int[j,i] = l2
                 if verbose:
-                    printmes = ('Res:',res,'Max:',eres,"WTYPE:",wtype)
+                    printmes = ('Res:',res_vals[i],'Max:',eres,"WTYPE:",wtype)
                     print("%s %f %s %f %s %s" % printmes)
-            res += dres
 
         for j in range(nwins):
             resint[j] = sres+dres*np.min(
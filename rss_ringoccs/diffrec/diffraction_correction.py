@@ -11,10 +11,14 @@
         #. rss_ringoccs
 """
 # Import dependencies for the diffcorr module
+import copy
 import numpy as np
 from scipy.special import lambertw, iv
 from rss_ringoccs.tools.history import write_history_dict
 from rss_ringoccs.tools.write_output_files import write_output_files
+from rss_ringoccs.tools import instrument
+from . import native
+from .window_functions import window_cache
 
 # Declare constant for the speed of light (km/s)
 SPEED_OF_LIGHT_KM = 299792.4580
@@ -33,6 +37,14 @@ IV0_20 = 87.10850209627940
 IV0_25 = 373.02058499037486
 IV0_35 = 7257.7994923041760
 
+# Newton-Raphson settings for the stationary phase of psitype='full'.
+# The solve is warm-started from the previous point, except at window
+# resets and every NEWTON_BLOCK points, which keeps the native engine
+# independent of the number of threads.
+NEWTON_TOL = 1.0e-4
+NEWTON_MAX = 6
+NEWTON_BLOCK = 256
+
 # Dictionary containing regions of interest within the Saturnian Rings.
 region_dict = {
     'all':             [1.0, 400000.0],
@@ -175,6 +187,50 @@ class DiffractionCorrection(object):
 
                 The variable is neither case nor space sensitive.
                 Default is set to 'full'.
+            :engine (*str*):
+                A string for selecting how the Fresnel inversion
+                is computed. Allowed strings are:
+
+                |    'native'    Compiled engine in diffrec/src.
+                |    'python'    Reference loop written in Python.
+
+                The native engine must be built with config_src.sh.
+                If it is unavailable, the Python loop is used and
+                the engine attribute is set to 'python'. Both agree
+                to round-off. Default is 'native'.
+            :ncores (*int*):
+                The number of threads used by the native engine.
+                The reconstructed range is split into radial chunks
+                which are processed in parallel. The result does not
+                depend on the number of threads. This is ignored by
+                the Python engine. Default is 1.
+            :cache_windows (*bool*):
+                A Boolean for determining whether or not windows are
+                taken from the process-wide cache in window_functions.
+                Cached windows are keyed on the number of points in
+                the window and evaluated at the width nw_pts*dx_km,
+                so the same window is reused across ingress/egress,
+                resolutions, and Revs. The native engine evaluates
+                windows with the same rule. This changes the taper by
+                less than one sample in width. Default is False.
+            :method (*str*):
+                A string for selecting how the sum over the window
+                is evaluated. Allowed strings are:
+
+                |    'direct'    Sum over the window at every point.
+                |    'fft'       Overlap-save FFT convolution.
+
+                The 'fft' method is only available for
+                psitype='fresnel'. The range is split into blocks
+                in which F_km_vals and w_km_vals vary by less than
+                fft_tol, and every block is computed as a single
+                convolution with the kernel at the center of the
+                block. Blocks that are too short for this to pay off
+                fall back to the direct sum. Default is 'direct'.
+            :fft_tol (*float*):
+                Largest relative variation of the Fresnel scale and
+                the window width allowed within a single FFT block.
+                Ignored unless method='fft'. Default is 1e-4.
             :verbose (*bool*):
                 A Boolean for determining if various pieces of
                 information are printed to the screen or not.
@@ -186,6 +242,22 @@ class DiffractionCorrection(object):
                 History from DLP instance.
             :dx_km (*float*):
                 Radial spacing for the data points (km).
+            :engine (*str*):
+                The engine that was used for the Fresnel inversion.
+            :window_cache_stats (*dict*):
+                Hit and miss counters of the process-wide window
+                cache after reconstruction. None unless
+                cache_windows=True.
+            :fft_stats (*dict*):
+                Number of FFT blocks and of points computed by FFT
+                and by the direct sum for the inversion. None unless
+                method='fft'.
+            :psi_iter_hist (*np.ndarray*):
+                psi_iter_hist[k] is the number of points at which
+                the stationary phase was found in k Newton-Raphson
+                steps, k = 0, ..., NEWTON_MAX. The solve starts from
+                the solution at the previous point. None unless
+                psitype='full'.
             :f_sky_hz_vals (*np.ndarray*):
                 Recieved frequency from the spacecraft (Hz).
             :finish (*int*):
@@ -203,6 +275,8 @@ class DiffractionCorrection(object):
                 The sine of the ring opening angle (Unitless).
             :n_used (*int*):
                 Number of points that were reconstructed.
+            :ncores (*int*):
+                Number of threads for the native engine (See keywords).
             :norm (*bool*):
                 Boolean for norm (See keywords).
             :norm_eq (*float*):
@@ -291,7 +365,40 @@ class DiffractionCorrection(object):
     """
     def __init__(self, DLP, res, rng="all", wtype="kbmd20", fwd=False,
                  norm=True, verbose=False, bfac=True, sigma=2.e-13,
-                 psitype="fresnel4", write_file=False, res_factor=0.75):
+                 psitype="fresnel4", write_file=False, res_factor=0.75,
+                 engine="native", ncores=1, cache_windows=False,
+                 method="direct", fft_tol=1.e-4):
+
+        # Check the inputs and extract the data from the DLP.
+        self.__setup(DLP, res, rng=rng, wtype=wtype, fwd=fwd, norm=norm,
+                     verbose=verbose, bfac=bfac, sigma=sigma, psitype=psitype,
+                     res_factor=res_factor, engine=engine, ncores=ncores,
+                     cache_windows=cache_windows, method=method,
+                     fft_tol=fft_tol, write_file=write_file)
+
+        # Compute the window widths and the range of points to process.
+        self.__set_window_range(rng)
+
+        if self.verbose:
+            print("\tRunning Fresnel Inversion...")
+
+        self.T_vals = self.__ftrans(fwd=False)
+
+        self.__finalize(DLP, write_file)
+
+    def __setup(self, DLP, res, rng="all", wtype="kbmd20", fwd=False,
+                norm=True, verbose=False, bfac=True, sigma=2.e-13,
+                psitype="fresnel4", res_factor=0.75, engine="native",
+                ncores=1, cache_windows=False, method="direct", fft_tol=1.e-4,
+                write_file=False):
+        """
+            Purpose:
+                Check the inputs of DiffractionCorrection, extract
+                the data from the DLP instance, and compute all of
+                the variables that do not depend on the resolution
+                or the window type. See DiffractionCorrection for
+                the meaning of the arguments and keywords.
+        """
 
         # Make sure that verbose is a boolean.
         if not isinstance(verbose, bool):
@@ -310,63 +417,8 @@ class DiffractionCorrection(object):
         else:
             pass
 
-        # Check that the input resolution is a positive floating point number.
-        if (not isinstance(res, float)):
-            try:
-                res = float(res)
-            except (TypeError, ValueError):
-                raise TypeError(
-                    "\n\tError Encountered:\n"
-                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                    "\tres must be a positive floating point number\n"
-                    "\tYour input has type: %s\n"
-                    "\tInput should have type: float\n" % (type(res).__name__)
-                )
-        else:
-            pass
-
-        if (res <= 0.0):
-            raise ValueError(
-                "\n\tError Encountered:\n"
-                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                "\tres must be a positive floating point number\n"
-                "\tYour requested resolution (km): %f\n" % (res)
-            )
-        else:
-            pass
-
-        # Check that the requested window type is a legal input.
-        if not isinstance(wtype, str):
-            erm = ""
-            for key in self.__func_dict:
-                erm = "%s\t\t'%s'\n" % (erm, key)
-            raise TypeError(
-                "\n\tError Encountered:\n"
-                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                "\twtype must be a string.\n"
-                "\tYour input has type: %s\n"
-                "\tInput should have type: str\n"
-                "\tAllowed string are:\n%s" % (type(wtype).__name__, erm)
-            )
-        else:
-            # Remove spaces and quotes from the wtype variable.
-            wtype = wtype.replace(" ", "").replace("'", "").replace('"', "")
-
-            # Set wtype string to lower-case.
-            wtype = wtype.lower()
-            if not (wtype in self.__func_dict):
-                erm = ""
-                for key in self.__func_dict:
-                    erm = "%s\t\t'%s'\n" % (erm, key)
-                raise ValueError(
-                    "\n\tError Encountered:\n"
-                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                    "\tIllegal string used for wtype.\n"
-                    "\tYour string: '%s'\n"
-                    "\tAllowed Strings:\n%s" % (wtype, erm)
-                )
-            else:
-                pass
+        # Check the resolution and the window type.
+        res, wtype = self.__check_res_wtype(res, wtype)
 
         # Check that the forward boolean is valid.
         if not isinstance(fwd, bool):
@@ -480,127 +532,141 @@ class DiffractionCorrection(object):
             else:
                 pass
 
-        # Check that the requested range is a legal input.
-        if (not isinstance(rng, str)) and (not isinstance(rng, list)):
-            try:
-                if (np.size(rng) < 2):
-                    erm = ""
-                    for key in region_dict:
-                        erm = "%s\t\t'%s'\n" % (erm, key)
-                    raise TypeError(
-                        "\n\tError Encountered:\n"
-                        "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                        "\trng must be a list or a valid string.\n"
-                        "\tYour input has type: %s\n"
-                        "\tSet range=[a,b], where a is the STARTING point\n"
-                        "\tand b is the ENDING point of reconstruction, or\n"
-                        "\tuse one of the following valid strings:\n%s"
-                        % (type(rng).__name__, erm)
-                    )
-                elif (np.min(rng) < 0):
-                    raise ValueError(
-                        "\n\tError Encountered:\n"
-                        "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                        "\tMinimum requested range must be positive\n"
-                        "\tYour minimum requested range: %f\n" % (np.min(rng))
-                    )
-                else:
-                    rng = [np.min(rng), np.max(rng)]
-            except TypeError:
-                erm = ""
-                for key in region_dict:
-                    erm = "%s\t\t'%s'\n" % (erm, key)
-                raise TypeError(
+        # Check that engine is a valid string.
+        if not isinstance(engine, str):
+            raise TypeError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tengine must be a string.\n"
+                "\tYour input has type: %s\n"
+                "\tInput should have type: str\n"
+                "\tAllowed strings are:\n"
+                "\t\t'native'\n\t\t'python'\n" % (type(engine).__name__)
+            )
+        else:
+            engine = engine.replace(" ", "").replace("'", "")
+            engine = engine.replace('"', "").lower()
+
+            if not (engine in ["native", "python"]):
+                raise ValueError(
                     "\n\tError Encountered:\n"
                     "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                    "\trng must be a list of floating\n"
-                    "\tpoint numbers or a valid string.\n"
-                    "\tYour input has type: %s\n"
-                    "\tSet range=[a,b], where a is the STARTING point\n"
-                    "\tand b is the ENDING point of reconstruction, or\n"
-                    "\tuse one of the following valid strings:\n%s"
-                    % (type(rng).__name__, erm)
+                    "\tInvalid string for engine.\n"
+                    "\tYour string: '%s'\n"
+                    "\tAllowed strings are:\n"
+                    "\t\t'native'\n\t\t'python'\n" % (engine)
                 )
-        elif isinstance(rng, list):
-            # Try converting all elements to floating point numbers.
-            if (not all(isinstance(x, float) for x in rng)):
-                try:
-                    for i in np.arange(np.size(rng)):
-                        rng[i] = float(rng[i])
-                except (TypeError, ValueError):
-                    erm = ""
-                    for key in region_dict:
-                        erm = "%s\t\t'%s'\n" % (erm, key)
-                    raise TypeError(
-                        "\n\tError Encountered:\n"
-                        "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                        "\trng must be a list of floating\n"
-                        "\tpoint numbers or a valid string.\n"
-                        "\tYour input has type: %s\n"
-                        "\tSet range=[a,b], where a is the STARTING point\n"
-                        "\tand b is the ENDING point of reconstruction, or\n"
-                        "\tuse one of the following valid strings:\n%s"
-                        % (type(rng).__name__, erm)
-                    )
+            elif (engine == "native") and (not native.NATIVE_AVAILABLE):
+                if verbose:
+                    print("\tNative engine not built, using Python loop...")
+                engine = "python"
             else:
                 pass
 
-            # Check that there are at least two numbers.
-            if (np.size(rng) < 2):
-                erm = ""
-                for key in region_dict:
-                    erm = "%s\t\t'%s'\n" % (erm, key)
+        # Check that cache_windows boolean is valid.
+        if not isinstance(cache_windows, bool):
+            raise TypeError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tcache_windows must be Boolean: True/False\n"
+                "\tYour input has type: %s\n"
+                "\tInput should have type: bool\n"
+                "\tSet cache_windows=True or cache_windows=False\n"
+                % (type(cache_windows).__name__)
+            )
+        else:
+            pass
+
+        # Check that ncores is a positive integer.
+        if (not isinstance(ncores, int)) or isinstance(ncores, bool):
+            try:
+                if (ncores != int(ncores)):
+                    raise ValueError
+                ncores = int(ncores)
+            except (TypeError, ValueError):
                 raise TypeError(
                     "\n\tError Encountered:\n"
                     "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                    "\trng must contain two numbers: rng=[a,b]\n"
-                    "\tYou provided less than 2 numbers.\n"
-                    "\tSet range=[a,b], where a is the STARTING point\n"
-                    "\tand b is the ENDING point of reconstruction, or\n"
-                    "\tuse one of the following valid strings:\n%s" % (erm)
+                    "\tncores must be a positive integer.\n"
+                    "\tYour input has type: %s\n"
+                    "\tInput should have type: int\n"
+                    % (type(ncores).__name__)
                 )
-            else:
-                pass
+        else:
+            pass
 
-            # Check that the smallest number is positive.
-            if (np.min(rng) < 0.0):
+        if (ncores < 1):
+            raise ValueError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tncores must be a positive integer.\n"
+                "\tYour input: %d\n" % (ncores)
+            )
+        else:
+            pass
+
+        # Check that method is a valid string.
+        if not isinstance(method, str):
+            raise TypeError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tmethod must be a string.\n"
+                "\tYour input has type: %s\n"
+                "\tInput should have type: str\n"
+                "\tAllowed strings are:\n"
+                "\t\t'direct'\n\t\t'fft'\n" % (type(method).__name__)
+            )
+        else:
+            method = method.replace(" ", "").replace("'", "")
+            method = method.replace('"', "").lower()
+
+            if not (method in ["direct", "fft"]):
                 raise ValueError(
                     "\n\tError Encountered:\n"
                     "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                    "\tMinimum requested range must be positive\n"
-                    "\tYour minimum requested range: %f\n" % (np.min(rng))
+                    "\tInvalid string for method.\n"
+                    "\tYour string: '%s'\n"
+                    "\tAllowed strings are:\n"
+                    "\t\t'direct'\n\t\t'fft'\n" % (method)
+                )
+            elif (method == "fft") and (psitype != "fresnel"):
+                raise ValueError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                    "\tmethod='fft' requires psitype='fresnel'.\n"
+                    "\tYour psitype: '%s'\n"
+                    "\tThe other kernels are not convolutions.\n"
+                    % (psitype)
                 )
             else:
                 pass
-        elif isinstance(rng, str):
-            rng = rng.replace(" ", "").replace("'", "").replace('"', "")
-            rng = rng.lower()
-            if not (rng in region_dict):
-                erm = ""
-                for key in region_dict:
-                    erm = "%s\t\t'%s'\n" % (erm, key)
-                raise ValueError(
+
+        # Check that fft_tol is a positive floating point number.
+        if (not isinstance(fft_tol, float)):
+            try:
+                fft_tol = float(fft_tol)
+            except (TypeError, ValueError):
+                raise TypeError(
                     "\n\tError Encountered:\n"
                     "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                    "\tIllegal string used for rng.\n"
-                    "\tYour string: '%s'\n"
-                    "\tAllowed Strings:\n%s" % (rng, erm)
+                    "\tfft_tol must be a positive floating point number.\n"
+                    "\tYour input has type: %s\n" % (type(fft_tol).__name__)
                 )
         else:
-            erm = ""
-            for key in region_dict:
-                erm = "%s\t\t'%s'\n" % (erm, key)
-            raise TypeError(
+            pass
+
+        if (fft_tol <= 0.0):
+            raise ValueError(
                 "\n\tError Encountered:\n"
                 "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                "\trng must be a list of floating\n"
-                "\tpoint numbers or a valid string.\n"
-                "\tYour input has type: %s\n"
-                "\tSet range=[a,b], where a is the STARTING point\n"
-                "\tand b is the ENDING point of reconstruction, or\n"
-                "\tuse one of the following valid strings:\n%s"
-                % (type(rng).__name__, erm)
+                "\tfft_tol must be a positive floating point number.\n"
+                "\tYour input: %f\n" % (fft_tol)
             )
+        else:
+            pass
+
+        # Check that the requested range is a legal input.
+        rng = self.__check_rng(rng)
 
         # Check that the Allen Deviation is a legal value.
         if (not isinstance(sigma, float)):
@@ -636,12 +702,21 @@ class DiffractionCorrection(object):
         self.input_res = res
         self.verbose = verbose
         self.psitype = psitype
+        self.engine = engine
+        self.ncores = ncores
+        self.cache_windows = cache_windows
+        self.window_cache_stats = None
+        self.method = method
+        self.fft_tol = fft_tol
+        self.fft_stats = None
+        self.psi_iter_hist = None
         self.rngreq = rng
         self.wtype = wtype
         self.sigma = sigma
         self.norm = norm
         self.bfac = bfac
         self.res = res*res_factor
+        self.res_factor = res_factor
         self.fwd = fwd
 
         # Retrieve variables from the DLP class, setting as attributes.
@@ -937,7 +1012,6 @@ class DiffractionCorrection(object):
         # Compute sampling distance (km)
         self.dx_km = self.rho_km_vals[1] - self.rho_km_vals[0]
 
-        # Check that the data is well sampled for the requested resolution.
         if (self.dx_km == 0.0):
             raise ValueError(
                 "\n\tError Encountered:\n"
@@ -946,27 +1020,6 @@ class DiffractionCorrection(object):
                 "\tThe sample spacing is zero. Please\n"
                 "\tcheck the input data for errors."
             )
-        elif self.res < 1.999999*self.dx_km:
-            raise ValueError(
-                "\n\tError Encountered:\n"
-                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
-                "\tRequested resolution is less than twice the\n"
-                "\tsample spacing of the input data. This\n"
-                "\tviolates the sampling theorem and will result\n"
-                "\tin an inaccurate reconstruction.\n\n"
-                "\tRequested Resolution (km): %f\n"
-                "\tSample Spacing (km): %f\n\n"
-                "\tTO CORRECT THIS:\n"
-                "\t\tChoose a resolution GREATER than %f km\n"
-                "\n\tPLEASE NOTE:\n"
-                "\t\tTo be consistent with PDS results, a scale factor\n"
-                "\t\tof 0.75 is applied to your requested resolution.\n"
-                "\t\tto ignore this scale factor, please set the\n"
-                "\t\tkeyword 'res_factor=1.0' when calling the\n"
-                "\t\tDiffractionCorrection class.\n"
-                "\t\tres_factor is currently set to: %f"%
-                (self.res, self.dx_km, 2.0*self.dx_km/res_factor, res_factor)
-            )
         else:
             pass
 
@@ -1048,23 +1101,274 @@ class DiffractionCorrection(object):
         
         del cb, sb, sp
 
-        # Compute the Normalized Equaivalent Width (See MTR86 Equation 20)
-        self.norm_eq = self.__func_dict[wtype]["normeq"]
-
-        # Compute the window width. (See MTR86 Equations 19, 32, and 33).
-        if bfac:
-            omega = TWO_PI * self.f_sky_hz_vals
-            alpha = omega*omega * sigma*sigma / (2.0 * self.rho_dot_kms_vals)
-            P = self.res / (alpha * (self.F_km_vals*self.F_km_vals))
-            self.P = P
-
-            # Create a variable specifying where P>1 occurs.
-            Prange = (P > 1.0).nonzero()[0]
-
-            if (np.size(Prange) == 0):
-                raise IndexError(
-                    "\n\tError Encountered:\n"
-                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+    def __check_res_wtype(self, res, wtype):
+        """
+            Purpose:
+                Check that the resolution is a positive real number
+                and that the window type is a legal string.
+            Arguments:
+                :res (*float* or *int*):
+                    The requested resolution for processing (km).
+                :wtype (*str*):
+                    The requested tapering function.
+            Outputs:
+                :res (*float*):
+                    The resolution as a float.
+                :wtype (*str*):
+                    The window type with spaces and quotes removed,
+                    in lower-case.
+        """
+        # Check that the input resolution is a positive floating point number.
+        if (not isinstance(res, float)):
+            try:
+                res = float(res)
+            except (TypeError, ValueError):
+                raise TypeError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                    "\tres must be a positive floating point number\n"
+                    "\tYour input has type: %s\n"
+                    "\tInput should have type: float\n" % (type(res).__name__)
+                )
+        else:
+            pass
+
+        if (res <= 0.0):
+            raise ValueError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tres must be a positive floating point number\n"
+                "\tYour requested resolution (km): %f\n" % (res)
+            )
+        else:
+            pass
+
+        # Check that the requested window type is a legal input.
+        if not isinstance(wtype, str):
+            erm = ""
+            for key in self.__func_dict:
+                erm = "%s\t\t'%s'\n" % (erm, key)
+            raise TypeError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\twtype must be a string.\n"
+                "\tYour input has type: %s\n"
+                "\tInput should have type: str\n"
+                "\tAllowed string are:\n%s" % (type(wtype).__name__, erm)
+            )
+        else:
+            # Remove spaces and quotes from the wtype variable.
+            wtype = wtype.replace(" ", "").replace("'", "").replace('"', "")
+
+            # Set wtype string to lower-case.
+            wtype = wtype.lower()
+            if not (wtype in self.__func_dict):
+                erm = ""
+                for key in self.__func_dict:
+                    erm = "%s\t\t'%s'\n" % (erm, key)
+                raise ValueError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                    "\tIllegal string used for wtype.\n"
+                    "\tYour string: '%s'\n"
+                    "\tAllowed Strings:\n%s" % (wtype, erm)
+                )
+            else:
+                pass
+
+        return res, wtype
+
+    def __check_rng(self, rng):
+        """
+            Purpose:
+                Check that the requested range is a list of two
+                non-negative numbers or one of the strings in
+                region_dict.
+            Arguments:
+                :rng (*list* or *str*):
+                    The requested range for diffraction correction.
+            Outputs:
+                :rng (*list* or *str*):
+                    The range as a list of floats, or the string
+                    with spaces and quotes removed, in lower-case.
+        """
+        if (not isinstance(rng, str)) and (not isinstance(rng, list)):
+            try:
+                if (np.size(rng) < 2):
+                    erm = ""
+                    for key in region_dict:
+                        erm = "%s\t\t'%s'\n" % (erm, key)
+                    raise TypeError(
+                        "\n\tError Encountered:\n"
+                        "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                        "\trng must be a list or a valid string.\n"
+                        "\tYour input has type: %s\n"
+                        "\tSet range=[a,b], where a is the STARTING point\n"
+                        "\tand b is the ENDING point of reconstruction, or\n"
+                        "\tuse one of the following valid strings:\n%s"
+                        % (type(rng).__name__, erm)
+                    )
+                elif (np.min(rng) < 0):
+                    raise ValueError(
+                        "\n\tError Encountered:\n"
+                        "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                        "\tMinimum requested range must be positive\n"
+                        "\tYour minimum requested range: %f\n" % (np.min(rng))
+                    )
+                else:
+                    rng = [np.min(rng), np.max(rng)]
+            except TypeError:
+                erm = ""
+                for key in region_dict:
+                    erm = "%s\t\t'%s'\n" % (erm, key)
+                raise TypeError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                    "\trng must be a list of floating\n"
+                    "\tpoint numbers or a valid string.\n"
+                    "\tYour input has type: %s\n"
+                    "\tSet range=[a,b], where a is the STARTING point\n"
+                    "\tand b is the ENDING point of reconstruction, or\n"
+                    "\tuse one of the following valid strings:\n%s"
+                    % (type(rng).__name__, erm)
+                )
+        elif isinstance(rng, list):
+            # Try converting all elements to floating point numbers.
+            if (not all(isinstance(x, float) for x in rng)):
+                try:
+                    for i in np.arange(np.size(rng)):
+                        rng[i] = float(rng[i])
+                except (TypeError, ValueError):
+                    erm = ""
+                    for key in region_dict:
+                        erm = "%s\t\t'%s'\n" % (erm, key)
+                    raise TypeError(
+                        "\n\tError Encountered:\n"
+                        "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                        "\trng must be a list of floating\n"
+                        "\tpoint numbers or a valid string.\n"
+                        "\tYour input has type: %s\n"
+                        "\tSet range=[a,b], where a is the STARTING point\n"
+                        "\tand b is the ENDING point of reconstruction, or\n"
+                        "\tuse one of the following valid strings:\n%s"
+                        % (type(rng).__name__, erm)
+                    )
+            else:
+                pass
+
+            # Check that there are at least two numbers.
+            if (np.size(rng) < 2):
+                erm = ""
+                for key in region_dict:
+                    erm = "%s\t\t'%s'\n" % (erm, key)
+                raise TypeError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                    "\trng must contain two numbers: rng=[a,b]\n"
+                    "\tYou provided less than 2 numbers.\n"
+                    "\tSet range=[a,b], where a is the STARTING point\n"
+                    "\tand b is the ENDING point of reconstruction, or\n"
+                    "\tuse one of the following valid strings:\n%s" % (erm)
+                )
+            else:
+                pass
+
+            # Check that the smallest number is positive.
+            if (np.min(rng) < 0.0):
+                raise ValueError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                    "\tMinimum requested range must be positive\n"
+                    "\tYour minimum requested range: %f\n" % (np.min(rng))
+                )
+            else:
+                pass
+        elif isinstance(rng, str):
+            rng = rng.replace(" ", "").replace("'", "").replace('"', "")
+            rng = rng.lower()
+            if not (rng in region_dict):
+                erm = ""
+                for key in region_dict:
+                    erm = "%s\t\t'%s'\n" % (erm, key)
+                raise ValueError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                    "\tIllegal string used for rng.\n"
+                    "\tYour string: '%s'\n"
+                    "\tAllowed Strings:\n%s" % (rng, erm)
+                )
+        else:
+            erm = ""
+            for key in region_dict:
+                erm = "%s\t\t'%s'\n" % (erm, key)
+            raise TypeError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\trng must be a list of floating\n"
+                "\tpoint numbers or a valid string.\n"
+                "\tYour input has type: %s\n"
+                "\tSet range=[a,b], where a is the STARTING point\n"
+                "\tand b is the ENDING point of reconstruction, or\n"
+                "\tuse one of the following valid strings:\n%s"
+                % (type(rng).__name__, erm)
+            )
+
+        return rng
+
+    def __set_window_range(self, rng):
+        """
+            Purpose:
+                Compute the window width at every point for the
+                current resolution and window type, and the range
+                of points that can be reconstructed.
+            Arguments:
+                :rng (*list* or *str*):
+                    The requested range for diffraction correction.
+        """
+        # Check that the data is well sampled for the requested resolution.
+        if self.res < 1.999999*self.dx_km:
+            raise ValueError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tRequested resolution is less than twice the\n"
+                "\tsample spacing of the input data. This\n"
+                "\tviolates the sampling theorem and will result\n"
+                "\tin an inaccurate reconstruction.\n\n"
+                "\tRequested Resolution (km): %f\n"
+                "\tSample Spacing (km): %f\n\n"
+                "\tTO CORRECT THIS:\n"
+                "\t\tChoose a resolution GREATER than %f km\n"
+                "\n\tPLEASE NOTE:\n"
+                "\t\tTo be consistent with PDS results, a scale factor\n"
+                "\t\tof 0.75 is applied to your requested resolution.\n"
+                "\t\tto ignore this scale factor, please set the\n"
+                "\t\tkeyword 'res_factor=1.0' when calling the\n"
+                "\t\tDiffractionCorrection class.\n"
+                "\t\tres_factor is currently set to: %f"%
+                (self.res, self.dx_km, 2.0*self.dx_km/self.res_factor,
+                 self.res_factor)
+            )
+        else:
+            pass
+
+        # Compute the Normalized Equaivalent Width (See MTR86 Equation 20)
+        self.norm_eq = self.__func_dict[self.wtype]["normeq"]
+
+        # Compute the window width. (See MTR86 Equations 19, 32, and 33).
+        if self.bfac:
+            omega = TWO_PI * self.f_sky_hz_vals
+            alpha = omega*omega * self.sigma*self.sigma
+            alpha /= 2.0 * self.rho_dot_kms_vals
+            P = self.res / (alpha * (self.F_km_vals*self.F_km_vals))
+            self.P = P
+
+            # Create a variable specifying where P>1 occurs.
+            Prange = (P > 1.0).nonzero()[0]
+
+            if (np.size(Prange) == 0):
+                raise IndexError(
+                    "\n\tError Encountered:\n"
+                    "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
                     "\tThe P parameter in window width computation\n"
                     "\tis less than one for the entirety of the\n"
                     "\tdata set. Either rho_dot_km_vals is too small,\n"
@@ -1106,7 +1410,7 @@ class DiffractionCorrection(object):
             del omega, alpha, P, P1, P2, crange1, crange2
         else:
             Prange = np.arange(np.size(self.rho_km_vals))
-            self.w_km_vals = 2.0*self.F_km_vals*self.F_km_vals/res
+            self.w_km_vals = 2.0*self.F_km_vals*self.F_km_vals/self.input_res
         
         self.w_km_vals *= self.norm_eq
 
@@ -1195,31 +1499,41 @@ class DiffractionCorrection(object):
         self.finish = wrange[-1]
         self.n_used = 1 + (self.finish - self.start)
 
+    def __finalize(self, DLP, write_file):
+        """
+            Purpose:
+                Compute power, phase, and optical depth from the
+                reconstructed transmittance, run the forward model
+                if requested, trim the attributes to the processed
+                range, and write the history.
+            Arguments:
+                :DLP (*object*):
+                    The data set the reconstruction was computed from.
+                :write_file (*bool*):
+                    Write the output to file.
+        """
         # Create input variable and keyword dictionaries for history.
         input_vars = {
             'dlp_inst': DLP.history,
-            'res': res
+            'res': self.input_res
         }
 
         input_kwds = {
-            'rng': rng,
-            'wtype': wtype,
-            'fwd': fwd,
-            'norm': norm,
-            'bfac': bfac,
-            'sigma': sigma,
-            'psitype': psitype,
-            'res_factor': res_factor
+            'rng': self.rngreq,
+            'wtype': self.wtype,
+            'fwd': self.fwd,
+            'norm': self.norm,
+            'bfac': self.bfac,
+            'sigma': self.sigma,
+            'psitype': self.psitype,
+            'res_factor': self.res_factor,
+            'engine': self.engine,
+            'ncores': self.ncores,
+            'cache_windows': self.cache_windows,
+            'method': self.method,
+            'fft_tol': self.fft_tol
         }
 
-        # Delete unnecessary variables for clarity.
-        del rho, rho_min, rho_max, rng, norm, fwd, bfac, psitype, verbose
-
-        if self.verbose:
-            print("\tRunning Fresnel Inversion...")
-
-        self.T_vals = self.__ftrans(fwd=False)
-
         # Compute power and phase.
         if self.verbose:
             print("\tComputing Power and Phase...")
@@ -1234,6 +1548,12 @@ class DiffractionCorrection(object):
         if self.verbose:
             print("\tInversion Complete.")
 
+        if self.cache_windows:
+            self.window_cache_stats = window_cache.stats()
+            if self.verbose:
+                print("\tWindow Cache: %(hits)d hits, %(disk_hits)d disk "
+                      "hits, %(misses)d misses" % self.window_cache_stats)
+
         if self.fwd:
             if self.verbose:
                 print("\tComputing Forward Transform...")
@@ -1272,21 +1592,264 @@ class DiffractionCorrection(object):
         if self.verbose:
             print("\tDiffraction Correction Complete.")
 
-    def __rect(w_in, dx):
+    @classmethod
+    def batch(cls, DLP, resolutions, wtypes="kbmd20", rng="all", fwd=False,
+              norm=True, verbose=False, bfac=True, sigma=2.e-13,
+              psitype="fresnel4", write_file=False, res_factor=0.75,
+              engine="native", ncores=1, cache_windows=False,
+              method="direct", fft_tol=1.e-4, shared_sweep=False):
         """
             Purpose:
-                Compute the rectangular window function.
+                Perform diffraction correction on one data set for
+                every combination of several resolutions and window
+                types. The inputs are checked, and the geometry and
+                Fresnel scale are computed, only once. Each
+                reconstruction is then computed on its own, exactly
+                as DiffractionCorrection would with the same inputs,
+                with either engine.
             Arguments:
-                :w_in (*float*):
-                    The width of the window function to be computed.
-                    This value is in kilometers.
-                :dx (*float*):
-                    The spacing between points in the window.
-                    This is equivalent to the sample spacing.
-                    This value is in kilometers.
+                :DLP (*object*):
+                    The data set (See DiffractionCorrection).
+                :resolutions (*list*):
+                    The requested resolutions for processing (km).
+            Keywords:
+                :wtypes (*str* or *list*):
+                    The requested tapering functions. Default is
+                    'kbmd20'.
+                :shared_sweep (*bool*):
+                    With engine='python' and method='direct', compute
+                    all of the reconstructions in one sweep over the
+                    data: at every point psi is evaluated once over
+                    the widest window that is needed, and each
+                    narrower window uses the central part of it. The
+                    results then differ slightly from those of
+                    DiffractionCorrection (See notes). It has no
+                    effect with the native engine or method='fft'.
+                    Default is False. All other keywords are the same
+                    as for DiffractionCorrection and are used for
+                    every reconstruction.
             Outputs:
-                :w_func (*np.ndarray*):
-                    Window function of width
+                :rec (*object*):
+                    Instance of DiffractionCorrectionBatch.
+            Notes:
+                #.  With the shared sweep the distance to each point
+                    in the window is computed at every point, rather
+                    than being carried over from the last time the
+                    window was resized. For psitype='full' the
+                    Newton iteration is run over the widest window,
+                    starting from phi0 at every point, so the results
+                    agree with DiffractionCorrection to within the
+                    Newton tolerance rather than rounding error.
+        """
+        if isinstance(wtypes, str):
+            wtypes = [wtypes]
+        else:
+            wtypes = list(wtypes)
+
+        resolutions = list(np.atleast_1d(resolutions))
+
+        if not isinstance(shared_sweep, bool):
+            raise TypeError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tshared_sweep must be Boolean: True/False\n"
+                "\tYour input has type: %s\n"
+                "\tInput should have type: bool\n"
+                "\tSet shared_sweep=True or shared_sweep=False\n"
+                % (type(shared_sweep).__name__)
+            )
+        else:
+            pass
+
+        if (len(resolutions) == 0) or (len(wtypes) == 0):
+            raise ValueError(
+                "\n\tError Encountered:\n"
+                "\t\trss_ringoccs.diffrec.DiffractionCorrection\n\n"
+                "\tresolutions and wtypes must each contain\n"
+                "\tat least one element.\n"
+            )
+        else:
+            pass
+
+        # Check the inputs and extract the data once for all runs.
+        rec = cls.__new__(cls)
+        rec.__setup(DLP, resolutions[0], rng=rng, wtype=wtypes[0], fwd=fwd,
+                    norm=norm, verbose=verbose, bfac=bfac, sigma=sigma,
+                    psitype=psitype, res_factor=res_factor, engine=engine,
+                    ncores=ncores, cache_windows=cache_windows,
+                    method=method, fft_tol=fft_tol, write_file=write_file)
+
+        checked = [rec.__check_res_wtype(res, wtype)
+                   for wtype in wtypes for res in resolutions]
+
+        # Window widths and ranges for every run.
+        runs = []
+        for (res, wtype) in checked:
+            run = copy.copy(rec)
+            run.input_res = res
+            run.res = res*rec.res_factor
+            run.wtype = wtype
+
+            # The phase is restored in place by __finalize.
+            run.phase_rad_vals = np.copy(rec.phase_rad_vals)
+            run.__set_window_range(rng)
+            runs.append(run)
+
+        start = min([run.start for run in runs])
+        finish = max([run.finish for run in runs])
+        rho_km_vals = rec.rho_km_vals[start:finish+1]
+
+        if verbose:
+            print("\tRunning Fresnel Inversion for %d Reconstructions..."
+                  % (len(runs)))
+
+        if shared_sweep and (rec.engine == "python") and (
+                rec.method == "direct"):
+            T_vals = rec.__batch_ftrans(runs)
+            for k in range(len(runs)):
+                runs[k].T_vals = T_vals[k]
+        else:
+            for run in runs:
+                run.T_vals = run.__ftrans(fwd=False)
+
+        for run in runs:
+            run.__finalize(DLP, write_file)
+
+        # Arrange the runs by window type and then resolution.
+        n_res = len(resolutions)
+        profiles = [runs[j*n_res:(j+1)*n_res] for j in range(len(wtypes))]
+
+        return DiffractionCorrectionBatch(profiles, rho_km_vals, start)
+
+    @classmethod
+    def session(cls, DLP, res, wtype="kbmd20", fwd=False, norm=True,
+                verbose=False, bfac=True, sigma=2.e-13, psitype="fresnel4",
+                res_factor=0.75, engine="native", ncores=1,
+                cache_windows=False, method="direct", fft_tol=1.e-4):
+        """
+            Purpose:
+                Check the inputs and extract the data from the DLP
+                once, for reconstructions of one data set over
+                ranges that are chosen one at a time, such as when
+                a feature is first reconstructed on its own and the
+                range is then widened. Every reconstructed point is
+                kept, and a later reconstruction with the same
+                resolution and window type only computes the points
+                that have not been computed before.
+            Arguments:
+                :DLP (*object*):
+                    The data set (See DiffractionCorrection).
+                :res (*float* or *int*):
+                    The default resolution for processing (km).
+            Keywords:
+                :wtype (*str*):
+                    The default tapering function. All other
+                    keywords are the same as for
+                    DiffractionCorrection and are used for every
+                    reconstruction of the session.
+            Outputs:
+                :session (*object*):
+                    Instance of DiffractionCorrectionSession.
+        """
+        rec = cls.__new__(cls)
+        rec.__setup(DLP, res, rng="all", wtype=wtype, fwd=fwd, norm=norm,
+                    verbose=verbose, bfac=bfac, sigma=sigma, psitype=psitype,
+                    res_factor=res_factor, engine=engine, ncores=ncores,
+                    cache_windows=cache_windows, method=method,
+                    fft_tol=fft_tol)
+
+        return DiffractionCorrectionSession(rec, DLP)
+
+    def _session_run(self, DLP, rng, res, wtype, store, write_file):
+        """
+            Purpose:
+                Reconstruct a range for DiffractionCorrectionSession,
+                computing only the points that are not in the store.
+                Called on the untrimmed instance made by session.
+            Arguments:
+                :DLP (*object*):
+                    The data set the session was made from.
+                :rng (*list* or *str*):
+                    The requested range for diffraction correction.
+                :res (*float*):
+                    The requested resolution for processing (km).
+                :wtype (*str*):
+                    The requested tapering function.
+                :store (*dict*):
+                    Reconstructed points of the session. Keyed by
+                    resolution and window type, each value is the
+                    transmittance at every point of the data and a
+                    boolean array of the points that are computed.
+                :write_file (*bool*):
+                    Write the output to file.
+            Outputs:
+                :rec (*object*):
+                    Instance of DiffractionCorrection for the range.
+                :n_new (*int*):
+                    Number of points that had to be computed.
+        """
+        rng = self.__check_rng(rng)
+        res, wtype = self.__check_res_wtype(res, wtype)
+
+        run = copy.copy(self)
+        run.input_res = res
+        run.res = res*self.res_factor
+        run.wtype = wtype
+        run.rngreq = rng
+
+        # The phase is restored in place by __finalize.
+        run.phase_rad_vals = np.copy(self.phase_rad_vals)
+        run.__set_window_range(rng)
+
+        key = (res, wtype)
+        if key not in store:
+            n_pts = np.size(self.rho_km_vals)
+            store[key] = (np.zeros(n_pts, dtype=complex),
+                          np.zeros(n_pts, dtype=bool))
+        else:
+            pass
+
+        T_vals, done = store[key]
+
+        # Compute each run of consecutive points that is not stored.
+        todo = np.flatnonzero(~done[run.start:run.finish+1]) + run.start
+        for block in np.split(todo, np.flatnonzero(np.diff(todo) > 1) + 1):
+            if (np.size(block) == 0):
+                continue
+
+            start = int(block[0])
+            n_used = int(np.size(block))
+            with instrument.timer('diffrec.ftrans'):
+                if (run.method == "fft"):
+                    T_out = run.__fft_ftrans(run.T_hat_vals, start, n_used,
+                                             False)
+                else:
+                    T_out = run.__direct_ftrans(run.T_hat_vals, start,
+                                                n_used, False)
+
+            T_vals[start:start+n_used] = T_out[start:start+n_used]
+            done[start:start+n_used] = True
+
+        run.T_vals = np.copy(T_vals)
+        run.__finalize(DLP, write_file)
+
+        return run, np.size(todo)
+
+    def __rect(w_in, dx):
+        """
+            Purpose:
+                Compute the rectangular window function.
+            Arguments:
+                :w_in (*float*):
+                    The width of the window function to be computed.
+                    This value is in kilometers.
+                :dx (*float*):
+                    The spacing between points in the window.
+                    This is equivalent to the sample spacing.
+                    This value is in kilometers.
+            Outputs:
+                :w_func (*np.ndarray*):
+                    Window function of width
                     w_in and with sample spacing dx.
         """
         # Window functions have an odd number of points.
@@ -1340,6 +1903,10 @@ class DiffractionCorrection(object):
                     Window function of width
                     w_in and with sample spacing dx.
         """
+        # The compiled engine sums the series for I_0 in C.
+        if native.NATIVE_AVAILABLE:
+            return native.window("kb20", w_in, dx)
+
         # Window functions have an odd number of points.
         nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -1367,6 +1934,9 @@ class DiffractionCorrection(object):
                     Window function of width
                     w_in and with sample spacing dx.
         """
+        if native.NATIVE_AVAILABLE:
+            return native.window("kb25", w_in, dx)
+
         # Window functions have an odd number of points.
         nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -1397,6 +1967,9 @@ class DiffractionCorrection(object):
                     Window function of width
                     w_in and with sample spacing dx.
         """
+        if native.NATIVE_AVAILABLE:
+            return native.window("kb35", w_in, dx)
+
         # Window functions have an odd number of points.
         nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -1428,6 +2001,9 @@ class DiffractionCorrection(object):
                     Window function of width
                     w_in and with sample spacing dx.
         """
+        if native.NATIVE_AVAILABLE:
+            return native.window("kbmd20", w_in, dx)
+
         # Window functions have an odd number of points.
         nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -1456,6 +2032,9 @@ class DiffractionCorrection(object):
                     Window function of width
                     w_in and with sample spacing dx.
         """
+        if native.NATIVE_AVAILABLE:
+            return native.window("kbmd25", w_in, dx)
+
         # Window functions have an odd number of points.
         nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -1693,6 +2272,100 @@ class DiffractionCorrection(object):
 
         return psi_d2
 
+    def __dpsi_d2psi(self, kD, r, r0, phi, phi0, B, D):
+        """
+            Purpose:
+                Compute dpsi/dphi and d^2psi/dphi^2 together,
+                sharing the trigonometric terms. This gives the same
+                values as __dpsi and __d2psi.
+            Arguments:
+                :kD (*np.ndarray*):
+                    Wavenumber, unitless.
+                :r (*float*):
+                    Radius of reconstructed point, in kilometers.
+                :r0 (*np.ndarray*):
+                    Radius of region within window, in kilometers.
+                :phi (*np.ndarray*):
+                    Root values of dpsi/dphi, radians.
+                :phi0 (*float*):
+                    Ring azimuth angle corresponding to r, radians.
+                :B (*float*):
+                    Ring opening angle, in radians.
+                :D (*float*):
+                    Spacecraft-RIP distance, in kilometers.
+            Outputs:
+                :psi_d1 (*np.ndarray*):
+                    Partial derivative of psi with respect to phi.
+                :psi_d2 (*np.ndarray*):
+                    Second partial derivative of psi
+                    with respect to phi.
+        """
+        cos_phi = np.cos(phi)
+        sin_phi = np.sin(phi)
+        cos_dphi = np.cos(phi-phi0)
+        sin_dphi = np.sin(phi-phi0)
+        rcpr_D2 = 1.0/(D*D)
+        cb_D = np.cos(B)/D
+
+        # Xi and Eta variables (MTR86 Equations 4b and 4c).
+        xi = cb_D * (r * cos_phi - r0 * np.cos(phi0))
+        eta = (r0*r0 + r*r - 2.0*r*r0*cos_dphi) * rcpr_D2
+        rcpr_psi0 = 1.0/np.sqrt(1.0+eta-2.0*xi)
+
+        # Derivatives of xi and eta.
+        dxi = -cb_D * (r*sin_phi)
+        dxi2 = -cb_D * (r*cos_phi)
+        deta = 2.0*r*r0*sin_dphi*rcpr_D2
+        deta2 = 2.0*r*r0*cos_dphi*rcpr_D2
+
+        u = deta-2.0*dxi
+        psi_d1 = kD*(0.5*rcpr_psi0*u + dxi)
+        psi_d2 = -0.25*rcpr_psi0*rcpr_psi0*rcpr_psi0*u*u
+        psi_d2 += 0.5*rcpr_psi0*(deta2-2.0*dxi2) + dxi2
+        psi_d2 *= kD
+        return psi_d1, psi_d2
+
+    def __stationary_phi(self, kD, r, r0, phi, phi0, B, D):
+        """
+            Purpose:
+                Solve dpsi/dphi = 0 with Newton-Raphson, starting
+                from phi. Each element is iterated until
+                |dpsi/dphi| <= NEWTON_TOL, or until it has taken
+                NEWTON_MAX steps, and converged elements are
+                dropped from the remaining iterations.
+            Arguments:
+                :phi (*np.ndarray*):
+                    Starting guess, overwritten with the solution.
+                All other arguments are as for __dpsi_d2psi.
+            Outputs:
+                :phi (*np.ndarray*):
+                    Stationary azimuth angle, radians.
+                :loop (*int*):
+                    Number of Newton-Raphson steps that were taken.
+        """
+        psi_d1, psi_d2 = self.__dpsi_d2psi(kD, r, r0, phi, phi0, B, D)
+        active = (np.abs(psi_d1) > NEWTON_TOL).nonzero()[0]
+        psi_d1 = psi_d1[active]
+        psi_d2 = psi_d2[active]
+        loop = 0
+
+        while (np.size(active) > 0) and (loop < NEWTON_MAX):
+            # Newton-Raphson
+            phi[active] -= psi_d1 / psi_d2
+            loop += 1
+            if (loop == NEWTON_MAX):
+                break
+
+            psi_d1, psi_d2 = self.__dpsi_d2psi(kD[active], r, r0[active],
+                                               phi[active], phi0, B, D)
+            keep = (np.abs(psi_d1) > NEWTON_TOL).nonzero()[0]
+            active = active[keep]
+            psi_d1 = psi_d1[keep]
+            psi_d2 = psi_d2[keep]
+
+        return phi, loop
+
+    @instrument.timed('diffrec.ftrans')
     def __ftrans(self, fwd):
         """
             Purpose:
@@ -1708,13 +2381,6 @@ class DiffractionCorrection(object):
                 :T_out (*np.ndarray*):
                     Complex transmittance.
         """
-        # Compute product of wavenumber and RIP distance.
-        kD_vals = TWO_PI * self.D_km_vals / self.lambda_sky_km_vals
-
-        # Define functions.
-        fw = self.__func_dict[self.wtype]["func"]
-        mes = "\t\tPt: %d  Tot: %d  Width: %d  Psi Iters: %d"
-
         # If forward transform, adjust starting point by half a window.
         if fwd:
             w_max = np.max(self.w_km_vals[self.start:self.start + self.n_used])
@@ -1726,13 +2392,252 @@ class DiffractionCorrection(object):
             start = self.start
             n_used = self.n_used
             T_in = self.T_hat_vals
-        
-        # Create empty array for reconstruction / forward transform.
+
+        if (self.method == "fft"):
+            return self.__fft_ftrans(T_in, start, n_used, fwd)
+        else:
+            return self.__direct_ftrans(T_in, start, n_used, fwd)
+
+    def __fft_blocks(self, start, n_used):
+        """
+            Purpose:
+                Split the points [start, start+n_used) into blocks
+                in which the Fresnel scale and the window width
+                each vary by less than fft_tol, relative to their
+                values at the start of the block.
+            Arguments:
+                :start (*int*):
+                    First point to be computed.
+                :n_used (*int*):
+                    Number of points to be computed.
+            Outputs:
+                :blocks (*list*):
+                    List of (a, b) pairs, the block being [a, b).
+        """
+        F = self.F_km_vals[start:start+n_used]
+        w = self.w_km_vals[start:start+n_used]
+        blocks = []
+        a = 0
+
+        while (a < n_used):
+            # Search ahead in steps that double in size, so that the
+            # cost of finding a block is proportional to its length.
+            m = 64
+            while True:
+                b = min(a+m, n_used)
+                Fb = F[a:b]
+                wb = w[a:b]
+                dF = np.maximum.accumulate(Fb) - np.minimum.accumulate(Fb)
+                dw = np.maximum.accumulate(wb) - np.minimum.accumulate(wb)
+                bad = (dF > self.fft_tol*F[a]) | (dw > self.fft_tol*w[a])
+                if np.any(bad):
+                    b = a + np.argmax(bad)
+                    break
+                elif (b == n_used):
+                    break
+                else:
+                    m *= 2
+
+            blocks.append((start+a, start+b))
+            a = b
+
+        return blocks
+
+    def __fft_ftrans(self, T_in, start, n_used, fwd):
+        """
+            Purpose:
+                Compute the Fresnel Inversion for psitype='fresnel'
+                with overlap-save FFT convolution. Within a block of
+                nearly constant F and w the kernel
+                w(x) exp(-i pi x^2 / 2F^2) is the same for every
+                point, so the sum over the window is a convolution.
+                Blocks that are too short for the FFT to be cheaper
+                than the direct sum are passed to __direct_ftrans.
+            Arguments:
+                :T_in (*np.ndarray*):
+                    Complex transmittance to be transformed.
+                :start (*int*):
+                    First point to be computed.
+                :n_used (*int*):
+                    Number of points to be computed.
+                :fwd (*bool*):
+                    Boolean for whether or not the forward
+                    calculation is being performed.
+            Outputs:
+                :T_out (*np.ndarray*):
+                    Complex transmittance.
+        """
+        if self.cache_windows:
+            wtype = self.wtype
+            fw = lambda w_in, dx: window_cache.window(wtype, w_in, dx)
+        else:
+            fw = self.__func_dict[self.wtype]["func"]
+
+        dx = self.dx_km
         T_out = T_in * 0.0
+        direct = []
+        n_blocks = 0
+
+        # Ranges left to the direct sum, merged where they touch.
+        def add_direct(a, b):
+            if (b <= a):
+                return
+            elif (len(direct) > 0) and (direct[-1][1] == a):
+                direct[-1] = (direct[-1][0], b)
+            else:
+                direct.append((a, b))
+
+        for (a, b) in self.__fft_blocks(start, n_used):
+            F = self.F_km_vals[a:b]
+            w = self.w_km_vals[a:b]
+
+            # Kernel evaluated at the middle of the block.
+            F_ref = 0.5*(np.max(F)+np.min(F))
+            w_func = fw(0.5*(np.max(w)+np.min(w)), dx)
+            nw = np.size(w_func)
+            nh = int((nw-1)/2)
+
+            # The window at the middle of the block can be wider than
+            # that of the points at its edges, and reach past the data
+            # near the ends of the range. Those points get the direct sum.
+            a_fft = min(max(a, nh), b)
+            b_fft = max(min(b, np.size(T_in)-nh), a_fft)
+            add_direct(a, a_fft)
+            if (b_fft <= a_fft):
+                add_direct(a_fft, b)
+                continue
+            a, b, tail = a_fft, b_fft, b
+            F = self.F_km_vals[a:b]
+
+            # FFT length, and the number of outputs from each segment.
+            nfft = int(2**np.ceil(np.log2(4*nw)))
+            step = nfft-nw+1
+            n_seg = int(np.ceil((b-a)/step))
+
+            # Fall back to the direct sum if the block is too short.
+            if ((b-a)*nw < 2.0*n_seg*nfft*np.log2(nfft)):
+                add_direct(a, tail)
+                continue
+            else:
+                n_blocks += 1
+
+            x = (np.arange(nw)-nh)*dx
+            psi_vals = HALF_PI * x * x / (F_ref*F_ref)
+
+            if fwd:
+                ker = w_func*np.exp(1j*psi_vals)
+            else:
+                ker = w_func*np.exp(-1j*psi_vals)
+
+            # Reversing the kernel turns the windowed sum into a convolution.
+            ker_hat = np.fft.fft(ker[::-1], nfft)
+
+            # Diffracted data in the block, padded to whole segments.
+            T = np.zeros(n_seg*step+nw-1, dtype=complex)
+            T[:b-a+nw-1] = T_in[a-nh:b+nh]
+            T_blk = np.zeros(n_seg*step, dtype=complex)
+
+            # Transform several segments at a time to limit memory use.
+            n_batch = max(1, int(4194304/nfft))
+            for s0 in range(0, n_seg, n_batch):
+                s1 = min(s0+n_batch, n_seg)
+                idx = (np.arange(s0, s1)*step)[:, None] + np.arange(nfft)
+                seg = np.fft.ifft(np.fft.fft(T[idx], axis=1)*ker_hat, axis=1)
+                T_blk[s0*step:s1*step] = seg[:, nw-1:].ravel()
+
+            # Same scale factor and normalization as the direct sum.
+            if self.norm:
+                T_out[a:b] = T_blk[:b-a]*(0.5+0.5j)*SQRT_2/np.abs(np.sum(ker))
+            else:
+                T_out[a:b] = T_blk[:b-a]*dx*(0.5+0.5j)/F
+
+            add_direct(b, tail)
+
+        n_direct = 0
+        for (a, b) in direct:
+            self.__direct_ftrans(T_in, a, b-a, fwd, T_out=T_out)
+            n_direct += b-a
+
+        instrument.count('diffrec.fft_blocks', n_blocks)
+        instrument.count('diffrec.fft_points', n_used-n_direct)
+
+        if not fwd:
+            self.fft_stats = {
+                "fft_blocks": n_blocks,
+                "fft_pts": n_used-n_direct,
+                "direct_pts": n_direct
+            }
+            if self.verbose:
+                print("\t\tFFT Blocks: %(fft_blocks)d  FFT Pts: %(fft_pts)d  "
+                      "Direct Pts: %(direct_pts)d" % self.fft_stats)
+
+        return T_out
+
+    def __direct_ftrans(self, T_in, start, n_used, fwd, T_out=None):
+        """
+            Purpose:
+                Compute the Fresnel Inversion by summing over the
+                window at every point.
+            Arguments:
+                :T_in (*np.ndarray*):
+                    Complex transmittance to be transformed.
+                :start (*int*):
+                    First point to be computed.
+                :n_used (*int*):
+                    Number of points to be computed.
+                :fwd (*bool*):
+                    Boolean for whether or not the forward
+                    calculation is being performed.
+            Keywords:
+                :T_out (*np.ndarray*):
+                    Complex array the size of T_in to write the
+                    points [start, start+n_used) into, leaving the
+                    others unchanged. If None, a new array of zeros
+                    is made. Default is None.
+            Outputs:
+                :T_out (*np.ndarray*):
+                    Complex transmittance.
+        """
+        # Compute product of wavenumber and RIP distance.
+        kD_vals = TWO_PI * self.D_km_vals / self.lambda_sky_km_vals
+
+        # Number of points that took 0, 1, ... Newton-Raphson steps.
+        iter_hist = np.zeros(NEWTON_MAX+1, dtype=int)
+        if (self.psitype == 'full') and (not fwd):
+            self.psi_iter_hist = iter_hist
+
+        instrument.count('diffrec.direct_points', n_used)
+
+        # Run the whole loop in the compiled engine if it was requested.
+        if (self.engine == "native"):
+            T_out = native.fresnel_transform(
+                self.rho_km_vals, T_in, self.F_km_vals, self.w_km_vals,
+                self.D_km_vals, self.B_rad_vals, self.phi_rad_vals, kD_vals,
+                self.dx_km, start, n_used, self.wtype, self.psitype,
+                self.norm, fwd, ncores=self.ncores,
+                canonical_windows=self.cache_windows, iter_hist=iter_hist,
+                T_out=T_out
+            )
+            instrument.count('diffrec.newton_iterations',
+                             int(np.dot(np.arange(NEWTON_MAX+1), iter_hist)))
+            return T_out
+
+        # Define functions.
+        if self.cache_windows:
+            wtype = self.wtype
+            fw = lambda w_in, dx: window_cache.window(wtype, w_in, dx)
+        else:
+            fw = self.__func_dict[self.wtype]["func"]
+        mes = "\t\tPt: %d  Tot: %d  Width: %d  Psi Iters: %d"
+
+        # Create empty array for reconstruction / forward transform.
+        if T_out is None:
+            T_out = T_in * 0.0
 
         # Compute first window width and window function.
         w_init = self.w_km_vals[start]
         w_func = fw(w_init, self.dx_km)
+        n_windows = 1
 
         # Compute number of points in window function
         nw = np.size(w_func)
@@ -1762,6 +2667,7 @@ class DiffractionCorrection(object):
                     # Reset w_init and recompute window function.
                     w_init = w
                     w_func = fw(w, self.dx_km)
+                    n_windows += 1
 
                     # Reset number of window points
                     nw = np.size(w_func)
@@ -1802,32 +2708,12 @@ class DiffractionCorrection(object):
                     print(mes % (i, n_used, nw, loop), end="\r")
             if self.verbose:
                 print("\n")
-        elif (self.psitype == 'fresnel3'):
+        elif (self.psitype != 'full'):
             crange -= 1
-            cosb = np.cos(self.B_rad_vals)
-            cosp = np.cos(self.phi_rad_vals)
-            sinp = np.sin(self.phi_rad_vals)
-            A_2 = 0.5*cosb*cosb*sinp*sinp/(1-cosb*cosb*sinp*sinp)
-
-            # Legendre polynomials
-            P_1 = cosb*cosp
-            P_1_1 = P_1*P_1
-            P_2 = (3.0*P_1_1-1.0)*0.5
-            P_1_2 = 2.0*P_1*P_2
-            P_3 = (5.0*P_1_1-3.0)*0.5*P_1
-
-            # Second set of polynomials.
-            b_0 = (1.0-P_1_1)*0.5
-            b_1 = (P_1-P_1*P_2)/3.0
-            b_2 = (P_2-P_1*P_3)*0.25
+            a_b, a_C, A_2 = self.__psi_coeffs(kD_vals)
 
             # Initial radial parameter
             x = r-r0
-            x2 = x*x
-
-            # D_km_vals and the square of it.
-            d = self.D_km_vals
-            d2 = d*d
 
             loop = 0
             for i in np.arange(n_used):
@@ -1842,6 +2728,7 @@ class DiffractionCorrection(object):
                     # Reset w_init and recompute window function.
                     w_init = w
                     w_func = fw(w, self.dx_km)
+                    n_windows += 1
 
                     # Reset number of window points
                     nw = np.size(w_func)
@@ -1854,17 +2741,10 @@ class DiffractionCorrection(object):
                     r = self.rho_km_vals[center]
                     r0 = self.rho_km_vals[crange]
                     x = r-r0
-                    x2 = x*x
                 else:
                     crange += 1
-                
-                z = x/d[center]
-                z2 = x2/d2[center]
 
-                psi_vals = z2*(b_0[center]-A_2[center]*P_1_1[center]+
-                               (b_1[center]-A_2[center]*P_1_2[center])*z)
-
-                psi_vals *= kD_vals[center]
+                psi_vals = self.__psi_horner(x, a_b, a_C, A_2, center, crange)
 
                 # Compute kernel function for Fresnel inverse
                 if fwd:
@@ -1885,43 +2765,14 @@ class DiffractionCorrection(object):
                     print(mes % (i, n_used, nw, loop), end="\r")
             if self.verbose:
                 print("\n", end="\r")
-        elif (self.psitype == 'fresnel4'):
-            crange -= 1
-            cosb = np.cos(self.B_rad_vals)
-            cosp = np.cos(self.phi_rad_vals)
-            sinp = np.sin(self.phi_rad_vals)
-            A_2 = 0.5*cosb*cosb*sinp*sinp/(1.0-cosb*cosb*sinp*sinp)
-
-            # Legendre polynomials
-            P_1 = cosb*cosp
-            P12 = P_1*P_1
-            P_2 = (3.0*P12-1.0)*0.5
-            P_3 = (5.0*P12-3.0)*0.5*P_1
-
-            # Products of Legendre Polynomials used in Expansion
-            C_0 = P_1*P_1
-            C_1 = 2.0*P_1*P_2
-            C_2 = P_2*P_2
-
-            # Second set of polynomials.
-            b_0 = (1.0-P12)*0.5
-            b_1 = (P_1-P_1*P_2)/3.0
-            b_2 = (P_2-P_1*P_3)*0.25
-
-            # Initial radial parameter
-            x = (r-r0)
-            x2 = x*x
-
-            # D_km_vals and the square of it.
-            d = self.D_km_vals
-            d2 = d*d
-
-            loop = 0
+        else:
+            phi = np.zeros(0)
+            phi_prev = 0.0
             for i in np.arange(n_used):
                 # Current point being computed.
                 center = start+i
 
-                # Window width and Frensel scale for current point.
+                # Current window width and Fresnel scale.
                 w = self.w_km_vals[center]
                 F = self.F_km_vals[center]
 
@@ -1929,132 +2780,40 @@ class DiffractionCorrection(object):
                     # Reset w_init and recompute window function.
                     w_init = w
                     w_func = fw(w, self.dx_km)
+                    n_windows += 1
 
                     # Reset number of window points
                     nw = np.size(w_func)
 
-                    # Computed range for current point
-                    crange = np.arange(int(center-(nw-1)/2),
-                                       int(1+center+(nw-1)/2))
-
-                    # Ajdust ring radius by dx_km.
-                    r = self.rho_km_vals[center]
-                    r0 = self.rho_km_vals[crange]
-                    x = r-r0
-                    x2 = x*x
+                    # Solve for the new window from scratch.
+                    phi = np.zeros(0)
                 else:
-                    crange += 1
-
-                z = x/d[center]
-                z2 = x2/d2[center]
-
-                psi_vals = b_0[center]-A_2[center]*C_0[center]
-                psi_vals += z*(b_1[center]-A_2[center]*C_1[center])
-                psi_vals += z2*(b_2[center]-A_2[center]*C_2[center])
-                psi_vals *= kD_vals[center]*z2
-
-                # Compute kernel function for Fresnel inverse
-                if fwd:
-                    ker = w_func*np.exp(1j*psi_vals)
-                else:
-                    ker = w_func*np.exp(-1j*psi_vals)
-
-                # Range of diffracted data that falls inside the window
-                T = T_in[crange]
-
-                # Compute 'approximate' Fresnel Inversion for current point
-                T_out[center] = np.sum(ker*T)*self.dx_km*(1.0+1.0j)/(2.0*F)
-
-                # If normalization has been set, normalize the reconstruction
-                if self.norm:
-                    T_out[center] *= self.__normalize(self.dx_km, ker, F)
-                if self.verbose:
-                    print(mes % (i, n_used, nw, loop), end="\r")
-            if self.verbose:
-                print("\n", end="\r")
-        elif (self.psitype == 'fresnel6'):
-            crange -= 1
-            cosb = np.cos(self.B_rad_vals)
-            cosp = np.cos(self.phi_rad_vals)
-            sinp = np.sin(self.phi_rad_vals)
-            A_2 = 0.5*cosb*cosb*sinp*sinp/(1.0-cosb*cosb*sinp*sinp)
-
-            # Legendre polynomials
-            P_1 = cosb*cosp
-            P12 = P_1*P_1
-            P_2 = (3.0*P12-1.0)*0.5
-            P_3 = (5.0*P12-3.0)*0.5*P_1
-            P_4 = (35.0*P12*P12-30.0*P12+3.0)/8.0
-            P_5 = P_1*(63.0*P12*P12-70.0*P12+15.0)/8.0
-
-            # Second set of polynomials.
-            b_0 = (1.0-P12)*0.5
-            b_1 = (P_1-P_1*P_2)/3.0
-            b_2 = (P_2-P_1*P_3)*0.25
-            b_3 = (P_3-P_1*P_4)*0.2
-            b_4 = (P_4-P_1*P_5)/6.0
-
-            x = r-r0
-            x2 = x*x
-            x3 = x2*x
-            x4 = x3*x
-
-            # Products of Legendre Polynomials used in Expansion
-            C_0 = P_1*P_1
-            C_1 = 2.0*P_1*P_2
-            C_2 = P_2*P_2+2.0*P_1*P_3
-            C_3 = 2.0*P_2*P_3
-            C_4 = P_3*P_3
-
-            # D_km_vals and various powers.
-            d = self.D_km_vals
-            d2 = d*d
-            d3 = d*d2
-            d4 = d*d3
-
-            loop = 0
-            for i in np.arange(n_used):
-                # Current point being computed.
-                center = start+i
-
-                # Window width and Frensel scale for current point.
-                w = self.w_km_vals[center]
-                F = self.F_km_vals[center]
-
-                if (np.abs(w_init - w) >= 2.0 * self.dx_km):
-                    # Reset w_init and recompute window function.
-                    w_init = w
-                    w_func = fw(w, self.dx_km)
-
-                    # Reset number of window points
-                    nw = np.size(w_func)
+                    pass
 
-                    # Computed range for current point
-                    crange = np.arange(int(center-(nw-1)/2),
-                                       int(1+center+(nw-1)/2))
+                # Computed range for current point
+                crange = np.arange(int(center-(nw-1)/2),
+                                   int(1+center+(nw-1)/2))
+                
+                # Ajdust ring radius by dx_km.
+                r = self.rho_km_vals[center]
+                r0 = self.rho_km_vals[crange]
+                d = self.D_km_vals[center]
+                b = self.B_rad_vals[center]
+                phi0 = self.phi_rad_vals[center]
+                kD = kD_vals[crange]
 
-                    # Ajdust ring radius by dx_km.
-                    r = self.rho_km_vals[center]
-                    r0 = self.rho_km_vals[crange]
-                    x = r-r0
-                    x2 = x*x
-                    x3 = x2*x
-                    x4 = x3*x
+                # Start from the previous solution, moved to this point.
+                if (i % NEWTON_BLOCK == 0) or (np.size(phi) != nw):
+                    phi = phi0 + np.zeros(nw)
                 else:
-                    crange += 1
-
-                z = x/d[center]
-                z2 = x2/d2[center]
-                z3 = x3/d3[center]
-                z4 = x4/d4[center]
+                    phi += phi0 - phi_prev
 
-                psi_vals = b_0[center]-A_2[crange]*C_0[center]
-                psi_vals += z*(b_1[center]-A_2[crange]*C_1[center])
-                psi_vals += z2*(b_2[center]-A_2[crange]*C_2[center])
-                psi_vals += z3*(b_3[center]-A_2[crange]*C_3[center])
-                psi_vals += z4*(b_4[center]-A_2[crange]*C_4[center])
+                phi, loop = self.__stationary_phi(kD, r, r0, phi, phi0, b, d)
+                phi_prev = phi0
+                iter_hist[loop] += 1
 
-                psi_vals *= z2*kD_vals[center]
+                # Compute Eta variable (MTR86 Equation 4c).
+                psi_vals = self.__psi_func(kD, r, r0, phi, phi0, b, d)
 
                 # Compute kernel function for Fresnel inverse
                 if fwd:
@@ -2072,196 +2831,415 @@ class DiffractionCorrection(object):
                 if self.norm:
                     T_out[center] *= self.__normalize(self.dx_km, ker, F)
                 if self.verbose:
-                    print(mes % (i, n_used, nw, loop), end="\r")
+                    print(mes % (i, n_used-1, nw, loop), end="\r")
             if self.verbose:
                 print("\n", end="\r")
-        elif (self.psitype == 'fresnel8'):
-            crange -= 1
-            cosb = np.cos(self.B_rad_vals)
-            cosp = np.cos(self.phi_rad_vals)
-            sinp = np.sin(self.phi_rad_vals)
-            A_2 = 0.5*cosb*cosb*sinp*sinp/(1.0-cosb*cosb*sinp*sinp)
-
-            # Legendre polynomials
-            P_1 = cosb*cosp
-            P12 = P_1*P_1
-            P_2 = (3.0*P12-1.0)*0.5
-            P_3 = P_1*(5.0*P12-3.0)*0.5
-            P_4 = (35.0*P12*P12-30.0*P12+3.0)/8.0
-            P_5 = P_1*(63.0*P12*P12-70.0*P12+15.0)/8.0
-            P_6 = (231.0*P12*P12*P12-315.0*P12*P12+105.0*P12-5.0)/16.0
-
-            # Products of Legendre Polynomials used in Expansion
-            C_0 = P_1*P_1
-            C_1 = 2.0*P_1*P_2
-            C_2 = 2.0*P_1*P_3+P_2*P_2
-            C_3 = 2.0*P_1*P_4+2.0*P_2*P_3
-            C_4 = 2.0*P_2*P_4+P_3*P_3
-            C_5 = 2.0*P_3*P_4
-            C_6 = P_4*P_4
-
-            # Second set of polynomials.
-            b_0 = (1.0-P12)/2.0
-            b_1 = (P_1-P_1*P_2)/3.0
-            b_2 = (P_2-P_1*P_3)/4.0
-            b_3 = (P_3-P_1*P_4)/5.0
-            b_4 = (P_4-P_1*P_5)/6.0
-            b_5 = (P_5-P_1*P_4)/7.0
-            b_6 = (P_6-P_1*P_5)/8.0
-
-            x = (r-r0)
-            x2 = x*x
-            x3 = x2*x
-            x4 = x3*x
-            x5 = x4*x
-            x6 = x5*x
-
-            # D_km_vals and various powers.
-            d = self.D_km_vals
-            d2 = d*d
-            d3 = d*d2
-            d4 = d*d3
-            d5 = d*d4
-            d6 = d*d5
 
-            loop = 0
-            for i in np.arange(n_used):
-                # Current point being computed.
-                center = start+i
-
-                # Window width and Frensel scale for current point.
-                w = self.w_km_vals[center]
-                F = self.F_km_vals[center]
-
-                if (np.abs(w_init - w) >= 2.0 * self.dx_km):
-                    # Reset w_init and recompute window function.
-                    w_init = w
-                    w_func = fw(w, self.dx_km)
-
-                    # Reset number of window points
-                    nw = np.size(w_func)
-
-                    # Computed range for current point
-                    crange = np.arange(int(center-(nw-1)/2),
-                                       int(1+center+(nw-1)/2))
-
-                    # Ajdust ring radius by dx_km.
-                    r = self.rho_km_vals[center]
-                    r0 = self.rho_km_vals[crange]
-                    x = r-r0
-                    x2 = x*x
-                    x3 = x2*x
-                    x4 = x3*x
-                    x5 = x4*x
-                    x6 = x5*x
-                else:
-                    crange += 1
+        instrument.count('diffrec.window_recomputations', n_windows)
+        instrument.count('diffrec.newton_iterations',
+                         int(np.dot(np.arange(NEWTON_MAX+1), iter_hist)))
+        return T_out
 
-                z = x/d[center]
-                z2 = x2/d2[center]
-                z3 = x3/d3[center]
-                z4 = x4/d4[center]
-                z5 = x5/d5[center]
-                z6 = x6/d6[center]
+    def __legendre_coeffs(self):
+        """
+            Purpose:
+                Compute the coefficients of the Legendre expansion
+                of psi used by the psitypes fresnel3 through
+                fresnel8. Each psitype has slightly different
+                expressions, reproduced here as they were first
+                written.
+            Outputs:
+                :A_2 (*np.ndarray*):
+                    The A_2 term of the expansion.
+                :b_list (*list*):
+                    The b_k polynomials, k = 0, 1, ...
+                :C_list (*list*):
+                    The products of Legendre polynomials C_k.
+        """
+        cosb = np.cos(self.B_rad_vals)
+        cosp = np.cos(self.phi_rad_vals)
+        sinp = np.sin(self.phi_rad_vals)
+        A_2 = 0.5*cosb*cosb*sinp*sinp/(1.0-cosb*cosb*sinp*sinp)
+
+        # Legendre polynomials
+        P_1 = cosb*cosp
+        P12 = P_1*P_1
+        P_2 = (3.0*P12-1.0)*0.5
+        P_3 = (5.0*P12-3.0)*0.5*P_1
+        P_4 = (35.0*P12*P12-30.0*P12+3.0)/8.0
+        P_5 = P_1*(63.0*P12*P12-70.0*P12+15.0)/8.0
+        P_6 = (231.0*P12*P12*P12-315.0*P12*P12+105.0*P12-5.0)/16.0
+
+        # Second set of polynomials.
+        b_list = [(1.0-P12)*0.5, (P_1-P_1*P_2)/3.0, (P_2-P_1*P_3)*0.25]
+
+        if (self.psitype == 'fresnel3'):
+            return A_2, b_list[:2], [P12, 2.0*P_1*P_2]
+        elif (self.psitype == 'fresnel4'):
+            return A_2, b_list, [P12, 2.0*P_1*P_2, P_2*P_2]
+        elif (self.psitype == 'fresnel6'):
+            b_list += [(P_3-P_1*P_4)*0.2, (P_4-P_1*P_5)/6.0]
+            C_list = [P12, 2.0*P_1*P_2, P_2*P_2+2.0*P_1*P_3,
+                      2.0*P_2*P_3, P_3*P_3]
+            return A_2, b_list, C_list
+        else:
+            b_list += [(P_3-P_1*P_4)*0.2, (P_4-P_1*P_5)/6.0,
+                       (P_5-P_1*P_4)/7.0, (P_6-P_1*P_5)/8.0]
+            C_list = [P12, 2.0*P_1*P_2, 2.0*P_1*P_3+P_2*P_2,
+                      2.0*P_1*P_4+2.0*P_2*P_3, 2.0*P_2*P_4+P_3*P_3,
+                      2.0*P_3*P_4, P_4*P_4]
+            return A_2, b_list, C_list
+
+    def __psi_coeffs(self, kD_vals):
+        """
+            Purpose:
+                Compute, at every point, the coefficients of the
+                fresnel3...fresnel8 expansions of psi as a
+                polynomial in x = rho - r0. With z = x/D,
 
-                psi_vals = b_0[center]-A_2[crange]*C_0[center]
-                psi_vals += z*(b_1[center]-A_2[crange]*C_1[center])
-                psi_vals += z2*(b_2[center]-A_2[crange]*C_2[center])
-                psi_vals += z3*(b_3[center]-A_2[crange]*C_3[center])
-                psi_vals += z4*(b_4[center]-A_2[crange]*C_4[center])
-                psi_vals += z5*(b_5[center]-A_2[crange]*C_5[center])
-                psi_vals += z6*(b_6[center]-A_2[crange]*C_6[center])
+                |    psi = kD z^2 sum_k (b_k - A_2 C_k) z^k,
 
-                psi_vals *= z2*kD_vals[center]
+                so the coefficient of x^(k+2) is kD/D^(k+2) times
+                that of z^k. This is the same arithmetic as the
+                native engine.
+            Arguments:
+                :kD_vals (*np.ndarray*):
+                    Product of the wavenumber and D_km_vals.
+            Outputs:
+                :a_b (*list*):
+                    Coefficients of x^(k+2), k = 0, 1, ... For
+                    fresnel3 and fresnel4 the A_2 C_k terms are
+                    included, since A_2 is taken at the center.
+                :a_C (*list*):
+                    Coefficients of the A_2 C_k terms for fresnel6
+                    and fresnel8, which take A_2 across the window.
+                    None for fresnel3 and fresnel4.
+                :A_2 (*np.ndarray*):
+                    The A_2 term of the expansion.
+        """
+        A_2, b_list, C_list = self.__legendre_coeffs()
 
-                # Compute kernel function for Fresnel inverse
-                if fwd:
-                    ker = w_func*np.exp(1j*psi_vals)
-                else:
-                    ker = w_func*np.exp(-1j*psi_vals)
+        scale = kD_vals/(self.D_km_vals*self.D_km_vals)
+        a_b = []
+        a_C = []
+        for k in range(len(b_list)):
+            a_b.append(b_list[k]*scale)
+            a_C.append(C_list[k]*scale)
+            scale = scale/self.D_km_vals
 
-                # Range of diffracted data that falls inside the window
-                T = T_in[crange]
+        if self.psitype in ['fresnel3', 'fresnel4']:
+            for k in range(len(a_b)):
+                a_b[k] -= A_2*a_C[k]
+            a_C = None
 
-                # Compute 'approximate' Fresnel Inversion for current point
-                T_out[center] = np.sum(ker*T)*self.dx_km*(1.0+1.0j)/(2.0*F)
+        return a_b, a_C, A_2
 
-                # If normalization has been set, normalize the reconstruction
-                if self.norm:
-                    T_out[center] *= self.__normalize(self.dx_km, ker, F)
-                if self.verbose:
-                    print(mes % (i, n_used, nw, loop), end="\r")
-            if self.verbose:
-                print("\n", end="\r")
-        else:
-            for i in np.arange(n_used):
-                # Current point being computed.
-                center = start+i
+    def __psi_horner(self, x, a_b, a_C, A_2, center, crange):
+        """
+            Purpose:
+                Evaluate the expansion of psi across the window with
+                Horner's scheme, using the coefficients computed by
+                __psi_coeffs.
+            Arguments:
+                :x (*np.ndarray*):
+                    Distance from the center of the window (km).
+                :a_b (*list*):
+                    Coefficients from __psi_coeffs.
+                :a_C (*list*):
+                    Coefficients from __psi_coeffs, or None.
+                :A_2 (*np.ndarray*):
+                    The A_2 term from __psi_coeffs.
+                :center (*int*):
+                    Point being computed.
+                :crange (*np.ndarray*):
+                    Indices of the points in the window.
+            Outputs:
+                :psi_vals (*np.ndarray*):
+                    psi across the window.
+        """
+        n = len(a_b)
+        psi_vals = np.zeros(np.size(x)) + a_b[n-1][center]
+        for k in range(n-2, -1, -1):
+            psi_vals *= x
+            psi_vals += a_b[k][center]
+
+        if a_C is not None:
+            p_C = np.zeros(np.size(x)) + a_C[n-1][center]
+            for k in range(n-2, -1, -1):
+                p_C *= x
+                p_C += a_C[k][center]
+            p_C *= A_2[crange]
+            psi_vals -= p_C
+
+        psi_vals *= x
+        psi_vals *= x
+        return psi_vals
 
-                # Current window width and Fresnel scale.
-                w = self.w_km_vals[center]
-                F = self.F_km_vals[center]
+    @instrument.timed('diffrec.batch_ftrans')
+    def __batch_ftrans(self, runs):
+        """
+            Purpose:
+                Compute the Fresnel Inversion for several window
+                types and resolutions in one sweep over the data.
+                Every run keeps its own window function, which is
+                recomputed with the same rule as __direct_ftrans,
+                while psi is evaluated once per point over the
+                widest window of the runs that contain that point.
+            Arguments:
+                :runs (*list*):
+                    Instances of DiffractionCorrection that share
+                    the geometry of self, each with its own
+                    w_km_vals, wtype, start, and n_used.
+            Outputs:
+                :T_list (*list*):
+                    Complex transmittance of each run.
+        """
+        dx = self.dx_km
+        rho = self.rho_km_vals
+        T_in = self.T_hat_vals
+        kD_vals = TWO_PI * self.D_km_vals / self.lambda_sky_km_vals
+        mes = "\t\tPt: %d  Tot: %d  Width: %d  Psi Iters: %d"
 
-                if (np.abs(w_init - w) >= 2.0 * self.dx_km):
+        if (self.psitype == 'fresnel'):
+            F2 = self.F_km_vals*self.F_km_vals
+        elif (self.psitype != 'full'):
+            a_b, a_C, A_2 = self.__psi_coeffs(kD_vals)
+
+        # Window functions, and the points where they were computed.
+        fw_list = []
+        w_init = []
+        w_func = []
+        T_list = []
+        for run in runs:
+            if self.cache_windows:
+                fw = (lambda wtype: lambda w_in, dx:
+                      window_cache.window(wtype, w_in, dx))(run.wtype)
+            else:
+                fw = self.__func_dict[run.wtype]["func"]
+            fw_list.append(fw)
+            w_init.append(run.w_km_vals[run.start])
+            w_func.append(fw(w_init[-1], dx))
+            T_list.append(T_in * 0.0)
+
+            if (self.psitype == 'full'):
+                run.psi_iter_hist = np.zeros(NEWTON_MAX+1, dtype=int)
+
+        start = min([run.start for run in runs])
+        finish = max([run.finish for run in runs])
+        loop = 0
+        n_windows = len(runs)
+        n_iters = 0
+
+        for center in range(start, finish+1):
+            active = [k for k in range(len(runs))
+                      if (runs[k].start <= center <= runs[k].finish)]
+
+            for k in active:
+                w = runs[k].w_km_vals[center]
+                if (np.abs(w_init[k] - w) >= 2.0 * dx):
                     # Reset w_init and recompute window function.
-                    w_init = w
-                    w_func = fw(w, self.dx_km)
-
-                    # Reset number of window points
-                    nw = np.size(w_func)
-                else:
-                    pass
-
-                # Computed range for current point
-                crange = np.arange(int(center-(nw-1)/2),
-                                   int(1+center+(nw-1)/2))
-                
-                # Ajdust ring radius by dx_km.
-                r = self.rho_km_vals[center]
-                r0 = self.rho_km_vals[crange]
+                    w_init[k] = w
+                    w_func[k] = fw_list[k](w, dx)
+                    n_windows += 1
+
+            # Widest window needed at this point.
+            nw = max([np.size(w_func[k]) for k in active])
+            crange = np.arange(int(center-(nw-1)/2), int(1+center+(nw-1)/2))
+            r = rho[center]
+            r0 = rho[crange]
+            F = self.F_km_vals[center]
+
+            if (self.psitype == 'fresnel'):
+                x = r-r0
+                psi_vals = HALF_PI * x * x / F2[center]
+            elif (self.psitype == 'full'):
                 d = self.D_km_vals[center]
                 b = self.B_rad_vals[center]
                 phi0 = self.phi_rad_vals[center]
-                phi = self.phi_rad_vals[center] + np.zeros(nw)
                 kD = kD_vals[crange]
 
-                # Compute Newton-Raphson perturbation
-                psi_d1 = self.__dpsi(kD, r, r0, phi, phi0, b, d)
-                loop = 0
-
-                while (np.max(np.abs(psi_d1)) > 1.0e-4):
-                    psi_d1 = self.__dpsi(kD, r, r0, phi, phi0, b, d)
-                    psi_d2 = self.__d2psi(kD, r, r0, phi, phi0, b, d)
-                    
-                    # Newton-Raphson
-                    phi += -(psi_d1 / psi_d2)
-
-                    # Add one to loop variable for each iteration
-                    loop += 1
-                    if (loop > 5):
-                        break
-
-                # Compute Eta variable (MTR86 Equation 4c).
+                # The widest window changes size, so always start cold.
+                phi = phi0 + np.zeros(nw)
+                phi, loop = self.__stationary_phi(kD, r, r0, phi, phi0, b, d)
                 psi_vals = self.__psi_func(kD, r, r0, phi, phi0, b, d)
+                n_iters += loop
+                for k in active:
+                    runs[k].psi_iter_hist[loop] += 1
+            else:
+                psi_vals = self.__psi_horner(r-r0, a_b, a_C, A_2,
+                                             center, crange)
 
-                # Compute kernel function for Fresnel inverse
-                if fwd:
-                    ker = w_func*np.exp(1j*psi_vals)
-                else:
-                    ker = w_func*np.exp(-1j*psi_vals)
+            ker_all = np.exp(-1j*psi_vals)
 
-                # Range of diffracted data that falls inside the window
-                T = T_in[crange]
+            for k in active:
+                nw_k = np.size(w_func[k])
+                i0 = int((nw-nw_k)/2)
+                ker = w_func[k]*ker_all[i0:i0+nw_k]
 
-                # Compute 'approximate' Fresnel Inversion for current point
-                T_out[center] = np.sum(ker*T)*self.dx_km*(1.0+1.0j)/(2.0*F)
+                # Range of diffracted data that falls inside the window
+                T = T_in[crange[i0:i0+nw_k]]
+                T_list[k][center] = np.sum(ker*T)*dx*(1.0+1.0j)/(2.0*F)
 
-                # If normalization has been set, normalize the reconstruction
                 if self.norm:
-                    T_out[center] *= self.__normalize(self.dx_km, ker, F)
-                if self.verbose:
-                    print(mes % (i, n_used-1, nw, loop), end="\r")
+                    T_list[k][center] *= self.__normalize(dx, ker, F)
+
             if self.verbose:
-                print("\n", end="\r")
+                print(mes % (center-start, finish-start, nw, loop), end="\r")
+        if self.verbose:
+            print("\n", end="\r")
 
-        return T_out
+        instrument.count('diffrec.batch_points', finish-start+1)
+        instrument.count('diffrec.window_recomputations', n_windows)
+        instrument.count('diffrec.newton_iterations', n_iters)
+
+        return T_list
+
+
+class DiffractionCorrectionBatch(object):
+    """
+        Purpose:
+            Hold the output of DiffractionCorrection.batch, with
+            the profiles of every run on a common radial grid.
+        Arguments:
+            :profiles (*list*):
+                Instances of DiffractionCorrection, indexed as
+                profiles[j][i] for window type j and resolution i.
+            :rho_km_vals (*np.ndarray*):
+                Ring radius covering all of the profiles (km).
+            :start (*int*):
+                Index of rho_km_vals[0] in the untrimmed data.
+        Attributes:
+            :profiles (*list*):
+                The DiffractionCorrection instances (See arguments).
+            :res_vals (*np.ndarray*):
+                Requested resolutions (km).
+            :wtypes (*list*):
+                Window types.
+            :rho_km_vals (*np.ndarray*):
+                Ring radius (km).
+            :power_vals (*np.ndarray*):
+                Normalized reconstructed power, with shape
+                (len(wtypes), len(res_vals), len(rho_km_vals)).
+                Points outside of the range of a profile are NaN.
+            :phase_vals (*np.ndarray*):
+                Reconstructed phase (Radians), same shape.
+            :tau_vals (*np.ndarray*):
+                Optical depth of the reconstructed data, same shape.
+            :T_vals (*np.ndarray*):
+                Reconstructed complex transmittance, same shape.
+    """
+    def __init__(self, profiles, rho_km_vals, start):
+        self.profiles = profiles
+        self.res_vals = np.array([rec.input_res for rec in profiles[0]])
+        self.wtypes = [row[0].wtype for row in profiles]
+        self.rho_km_vals = rho_km_vals
+
+        shape = (len(self.wtypes), np.size(self.res_vals),
+                 np.size(rho_km_vals))
+        self.power_vals = np.zeros(shape) + np.nan
+        self.phase_vals = np.zeros(shape) + np.nan
+        self.tau_vals = np.zeros(shape) + np.nan
+        self.T_vals = np.zeros(shape, dtype=complex) + np.nan
+
+        for j in range(len(self.wtypes)):
+            for i in range(np.size(self.res_vals)):
+                rec = profiles[j][i]
+                a = rec.start - start
+                b = a + rec.n_used
+                self.power_vals[j, i, a:b] = rec.power_vals
+                self.phase_vals[j, i, a:b] = rec.phase_vals
+                self.tau_vals[j, i, a:b] = rec.tau_vals
+                self.T_vals[j, i, a:b] = rec.T_vals
+
+
+class DiffractionCorrectionSession(object):
+    """
+        Purpose:
+            Reconstruct one data set over ranges chosen one at a
+            time, reusing every point that was already computed
+            with the same inputs. Made by DiffractionCorrection.session.
+        Arguments:
+            :rec (*object*):
+                Untrimmed instance of DiffractionCorrection holding
+                the checked data, made by DiffractionCorrection.session.
+            :DLP (*object*):
+                The data set the session was made from.
+        Attributes:
+            :res (*float*):
+                Default resolution (km).
+            :wtype (*str*):
+                Default window type.
+            :n_computed (*int*):
+                Number of points computed by the session.
+            :n_reused (*int*):
+                Number of points returned from the store instead.
+        Notes:
+            #.  A stored point is reused as it was computed. The
+                window function is only recomputed when the width
+                changes by two samples, starting from the first
+                point of a run, so a point reconstructed as part of
+                a different range can differ from that of a single
+                DiffractionCorrection by the window of a slightly
+                different width. The same applies to the starting
+                guess of the Newton iteration for psitype='full'.
+            #.  The forward model, if fwd=True, is computed again
+                over the whole range for every reconstruction.
+        Examples:
+            >>> session = DiffractionCorrection.session(dlp, 1.0)
+            >>> huygens = session.reconstruct([117650.0, 117950.0])
+            >>> wider = session.reconstruct([117000.0, 118500.0])
+            >>> finer = session.reconstruct([117650.0, 117950.0], res=0.5)
+    """
+    def __init__(self, rec, DLP):
+        self.rec = rec
+        self.DLP = DLP
+        self.res = rec.input_res
+        self.wtype = rec.wtype
+        self.store = {}
+        self.n_computed = 0
+        self.n_reused = 0
+
+    def reconstruct(self, rng="all", res=None, wtype=None, write_file=False):
+        """
+            Purpose:
+                Reconstruct a range, computing only the points that
+                have not been computed for the same resolution and
+                window type.
+            Keywords:
+                :rng (*list* or *str*):
+                    The requested range for diffraction correction
+                    (See DiffractionCorrection).
+                :res (*float*):
+                    The requested resolution (km). Default is the
+                    resolution of the session.
+                :wtype (*str*):
+                    The requested tapering function. Default is the
+                    window type of the session.
+                :write_file (*bool*):
+                    Write the output to file.
+            Outputs:
+                :rec (*object*):
+                    Instance of DiffractionCorrection for the range.
+        """
+        if res is None:
+            res = self.res
+        else:
+            pass
+
+        if wtype is None:
+            wtype = self.wtype
+        else:
+            pass
+
+        rec, n_new = self.rec._session_run(self.DLP, rng, res, wtype,
+                                           self.store, write_file)
+        self.n_computed += n_new
+        self.n_reused += rec.n_used - n_new
+        return rec
+
+    def clear(self):
+        """
+            Purpose:
+                Forget every stored point.
+        """
+        self.store.clear()
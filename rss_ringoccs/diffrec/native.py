@@ -0,0 +1,347 @@
+"""
+    Purpose:
+        Provide a ctypes binding to the compiled diffraction
+        reconstruction engine found in diffrec/src/. The shared
+        library is built by running config_src.sh from the top
+        level of the repository. If the library has not been
+        built, NATIVE_AVAILABLE is False and DiffractionCorrection
+        falls back to the pure Python loop. The library also has
+        compiled Fresnel integrals and Kaiser-Bessel windows, used by
+        special_functions and window_functions when it is available.
+    Dependencies:
+        #. numpy
+        #. ctypes
+        #. os
+        #. platform
+"""
+
+import os
+import ctypes
+import platform
+import numpy as np
+
+# Window and psi types, in the order of the enums in diffraction_functions.h
+WINDOW_TYPES = ["rect", "coss", "kb20", "kb25", "kb35", "kbmd20", "kbmd25"]
+PSI_TYPES = ["fresnel", "fresnel3", "fresnel4", "fresnel6", "fresnel8", "full"]
+
+# Error codes returned by the engine.
+ERROR_CODES = {
+    -1: "Illegal window type passed to the native engine.",
+    -2: "Illegal psitype passed to the native engine.",
+    -3: "Requested range extends beyond the available data.",
+    -4: "The native engine was unable to allocate memory."
+}
+
+if (platform.system() == "Darwin"):
+    LIB_NAME = "libdiffrec.dylib"
+else:
+    LIB_NAME = "libdiffrec.so"
+
+LIB_PATH = os.path.join(os.path.dirname(os.path.abspath(__file__)), LIB_NAME)
+
+_double_arr = np.ctypeslib.ndpointer(dtype=np.float64, flags="C_CONTIGUOUS")
+_complex_arr = np.ctypeslib.ndpointer(dtype=np.complex128,
+                                      flags="C_CONTIGUOUS")
+_long_arr = np.ctypeslib.ndpointer(dtype=np.dtype(ctypes.c_long),
+                                   flags="C_CONTIGUOUS")
+
+# Largest number of Newton-Raphson steps, RSS_NEWTON_MAX in the engine.
+NEWTON_MAX = 6
+
+try:
+    _lib = ctypes.CDLL(LIB_PATH)
+    _lib.rss_fresnel_transform.restype = ctypes.c_int
+    _lib.rss_fresnel_transform.argtypes = [
+        _double_arr,        # rho
+        _complex_arr,       # T_in
+        _double_arr,        # F
+        _double_arr,        # w
+        _double_arr,        # D
+        _double_arr,        # B
+        _double_arr,        # phi
+        _double_arr,        # kD
+        ctypes.c_double,    # dx
+        ctypes.c_long,      # n_pts
+        ctypes.c_long,      # start
+        ctypes.c_long,      # n_used
+        ctypes.c_int,       # wtype
+        ctypes.c_int,       # psitype
+        ctypes.c_int,       # norm
+        ctypes.c_int,       # fwd
+        ctypes.c_int,       # nthreads
+        ctypes.c_int,       # canonical
+        _complex_arr,       # T_out
+        _long_arr           # iter_hist
+    ]
+    _lib.rss_window_sum.restype = None
+    _lib.rss_window_sum.argtypes = [
+        _double_arr,        # psi
+        _double_arr,        # w_func
+        _complex_arr,       # T
+        ctypes.c_long,      # n
+        ctypes.c_double,    # sign
+        _complex_arr,       # sum_ker
+        _complex_arr        # sum_T
+    ]
+    _lib.rss_window.restype = ctypes.c_long
+    _lib.rss_window.argtypes = [
+        ctypes.c_int,       # wtype
+        ctypes.c_double,    # w_in
+        ctypes.c_double,    # dx
+        _double_arr         # w_func
+    ]
+    _lib.rss_window_kbal.restype = ctypes.c_long
+    _lib.rss_window_kbal.argtypes = [
+        ctypes.c_double,    # alpha
+        ctypes.c_int,       # modified
+        ctypes.c_double,    # w_in
+        ctypes.c_double,    # dx
+        _double_arr         # w_func
+    ]
+    _lib.rss_fresnel_cs.restype = None
+    _lib.rss_fresnel_cs.argtypes = [
+        _double_arr,        # x
+        ctypes.c_long,      # n
+        _double_arr,        # C
+        _double_arr         # S
+    ]
+    NATIVE_AVAILABLE = True
+except (OSError, AttributeError):
+    _lib = None
+    NATIVE_AVAILABLE = False
+
+
+def _check_available():
+    if not NATIVE_AVAILABLE:
+        raise ImportError(
+            "\n\tError Encountered:\n"
+            "\t\trss_ringoccs.diffrec.native\n\n"
+            "\tThe compiled engine %s could not be loaded.\n"
+            "\tRun config_src.sh to build it.\n" % LIB_PATH
+        )
+
+
+def fresnel_transform(rho, T_in, F, w, D, B, phi, kD, dx, start, n_used,
+                      wtype, psitype, norm, fwd, ncores=1,
+                      canonical_windows=False, iter_hist=None, T_out=None):
+    """
+        Purpose:
+            Compute the Fresnel inversion (or the forward model) with
+            the compiled engine. This is the native counterpart of
+            DiffractionCorrection.__ftrans.
+        Arguments:
+            :rho (*np.ndarray*):
+                Ring radius (km).
+            :T_in (*np.ndarray*):
+                Complex transmittance to be transformed.
+            :F (*np.ndarray*):
+                Fresnel scale (km).
+            :w (*np.ndarray*):
+                Window width (km).
+            :D (*np.ndarray*):
+                Spacecraft-RIP distance (km).
+            :B (*np.ndarray*):
+                Ring opening angle (radians).
+            :phi (*np.ndarray*):
+                Ring azimuth angle (radians).
+            :kD (*np.ndarray*):
+                Product of the wavenumber and D.
+            :dx (*float*):
+                Radial sample spacing (km).
+            :start (*int*):
+                First point to be computed.
+            :n_used (*int*):
+                Number of points to be computed.
+            :wtype (*str*):
+                Window type, one of WINDOW_TYPES.
+            :psitype (*str*):
+                Psi approximation, one of PSI_TYPES.
+            :norm (*bool*):
+                Normalize by the free space window integral.
+            :fwd (*bool*):
+                Compute the forward model instead of the inverse.
+        Keywords:
+            :ncores (*int*):
+                Number of threads used by the engine. The range is
+                split into radial chunks that are handed out to the
+                threads as they become free. The output is identical
+                for any number of threads. Default is 1.
+            :canonical_windows (*bool*):
+                Evaluate every window at the canonical width used by
+                window_functions.WindowCache, so that results match
+                a Python reconstruction with cache_windows=True.
+                Default is False.
+            :iter_hist (*np.ndarray*):
+                Array of NEWTON_MAX+1 integers. For psitype='full',
+                iter_hist[k] is incremented for every point whose
+                stationary phase took k Newton-Raphson steps.
+                Default is None.
+            :T_out (*np.ndarray*):
+                Contiguous complex128 array with as many points as
+                rho. If given, the range [start, start+n_used) is
+                written into it, and the points outside of it are
+                left unchanged. Default is None.
+        Outputs:
+            :T_out (*np.ndarray*):
+                Complex transmittance, zero outside of the
+                range [start, start+n_used) unless T_out was given.
+    """
+    _check_available()
+
+    rho = np.ascontiguousarray(rho, dtype=np.float64)
+    T_in = np.ascontiguousarray(T_in, dtype=np.complex128)
+    F = np.ascontiguousarray(F, dtype=np.float64)
+    w = np.ascontiguousarray(w, dtype=np.float64)
+    D = np.ascontiguousarray(D, dtype=np.float64)
+    B = np.ascontiguousarray(B, dtype=np.float64)
+    phi = np.ascontiguousarray(phi, dtype=np.float64)
+    kD = np.ascontiguousarray(kD, dtype=np.float64)
+    if T_out is None:
+        T_out = np.zeros(np.size(rho), dtype=np.complex128)
+    elif (np.size(T_out) != np.size(rho)):
+        raise ValueError(
+            "\n\tError Encountered:\n"
+            "\t\trss_ringoccs.diffrec.native\n\n"
+            "\tT_out must have as many points as rho.\n"
+        )
+    hist = np.zeros(NEWTON_MAX+1, dtype=np.dtype(ctypes.c_long))
+
+    status = _lib.rss_fresnel_transform(
+        rho, T_in, F, w, D, B, phi, kD, float(dx), int(np.size(rho)),
+        int(start), int(n_used), WINDOW_TYPES.index(wtype),
+        PSI_TYPES.index(psitype), int(norm), int(fwd), int(ncores),
+        int(canonical_windows), T_out, hist
+    )
+
+    if (status != 0):
+        raise RuntimeError(
+            "\n\tError Encountered:\n"
+            "\t\trss_ringoccs.diffrec.native\n\n"
+            "\t%s\n" % ERROR_CODES.get(status, "Unknown error.")
+        )
+
+    if iter_hist is not None:
+        iter_hist += hist
+
+    return T_out
+
+
+def window_sum(psi, w_func, T, fwd=False):
+    """
+        Purpose:
+            Sum one window against the Fresnel kernel with the
+            vectorized sine and cosine of the engine. This is the
+            inner sum of fresnel_transform, exposed for testing and
+            benchmarking against numpy.
+        Arguments:
+            :psi (*np.ndarray*):
+                Fresnel kernel phase over the window.
+            :w_func (*np.ndarray*):
+                Tapering function over the window.
+            :T (*np.ndarray*):
+                Complex transmittance over the window.
+        Keywords:
+            :fwd (*bool*):
+                Use exp(i psi), as in the forward model, instead of
+                exp(-i psi). Default is False.
+        Outputs:
+            :sum_ker (*complex*):
+                Sum of w_func*exp(-i psi).
+            :sum_T (*complex*):
+                Sum of w_func*exp(-i psi)*T.
+    """
+    _check_available()
+
+    psi = np.ascontiguousarray(psi, dtype=np.float64)
+    w_func = np.ascontiguousarray(w_func, dtype=np.float64)
+    T = np.ascontiguousarray(T, dtype=np.complex128)
+    sum_ker = np.zeros(1, dtype=np.complex128)
+    sum_T = np.zeros(1, dtype=np.complex128)
+
+    if (np.size(w_func) != np.size(psi)) or (np.size(T) != np.size(psi)):
+        raise ValueError(
+            "\n\tError Encountered:\n"
+            "\t\trss_ringoccs.diffrec.native\n\n"
+            "\tpsi, w_func and T must have the same size.\n"
+        )
+
+    if fwd:
+        sign = 1.0
+    else:
+        sign = -1.0
+
+    _lib.rss_window_sum(psi, w_func, T, int(np.size(psi)), sign,
+                        sum_ker, sum_T)
+    return sum_ker[0], sum_T[0]
+
+
+def window(wtype, w_in, dx, alpha=None):
+    """
+        Purpose:
+            Compute a tapering function with the compiled engine.
+            This gives the same windows as window_functions.py, with
+            I_0 summed in C rather than by scipy.special.iv. The
+            inputs are not checked, that is left to the caller.
+        Arguments:
+            :wtype (*str*):
+                Window type, one of WINDOW_TYPES, or 'kbal' or
+                'kbmdal' with the alpha keyword.
+            :w_in (*float*):
+                Window width.
+            :dx (*float*):
+                Width of one point.
+        Keywords:
+            :alpha (*float*):
+                Alpha parameter of 'kbal' and 'kbmdal'. Unlike the
+                al argument of window_functions.kbal, this is not
+                multiplied by pi.
+        Outputs:
+            :w_func (*np.ndarray*):
+                The window function.
+    """
+    _check_available()
+
+    w_in = float(w_in)
+    dx = float(dx)
+
+    # One spare point in case the C and Python rounding of the size differ.
+    w_func = np.zeros(int(2 * np.floor(w_in / (2.0 * dx)) + 2),
+                      dtype=np.float64)
+
+    if (wtype == "kbal") or (wtype == "kbmdal"):
+        nw_pts = _lib.rss_window_kbal(float(alpha), int(wtype == "kbmdal"),
+                                      w_in, dx, w_func)
+    else:
+        nw_pts = _lib.rss_window(WINDOW_TYPES.index(wtype), w_in, dx, w_func)
+
+    return w_func[:nw_pts]
+
+
+def fresnel_cs(x):
+    """
+        Purpose:
+            Compute the Fresnel cosine and sine integrals of a real
+            argument with the compiled engine, in the convention of
+            special_functions.fresnel_cos and fresnel_sin. Both come
+            from the same series or continued fraction, so computing
+            them together costs little more than either one.
+        Arguments:
+            :x (*np.ndarray* or *float*):
+                Real number or numpy array. The input is not checked,
+                that is left to the caller.
+        Outputs:
+            :f_cos (*np.ndarray*):
+                The Fresnel cosine integral of x.
+            :f_sin (*np.ndarray*):
+                The Fresnel sine integral of x.
+    """
+    _check_available()
+
+    x = np.asarray(x, dtype=np.float64)
+    shape = np.shape(x)
+    x = np.ascontiguousarray(x.ravel())
+    f_cos = np.zeros(np.size(x), dtype=np.float64)
+    f_sin = np.zeros(np.size(x), dtype=np.float64)
+
+    _lib.rss_fresnel_cs(x, int(np.size(x)), f_cos, f_sin)
+    return f_cos.reshape(shape), f_sin.reshape(shape)
@@ -1,6 +1,7 @@
 import numpy as np
 from scipy.special import erf, lambertw
 from . import window_functions
+from . import native
 
 # Declare constants for multiples of pi.
 TWO_PI = 6.283185307179586476925287
@@ -646,6 +647,8 @@ def fresnel_cos(x, error_check=True):
                 y = 2/sqrt(pi) * integral (t=0 to x) exp(-t^2)dt.
                 Using Euler's Formula for exponentials allows one
                 to use this to solve for the Fresnel Cosine integral.
+                For real x, the compiled engine in native.py is used
+                instead when it has been built.
             [3] The Fresnel Cosine integral is used for the solution
                 of diffraction through a square well. Because of this
                 it is useful for forward modeling problems in 
@@ -687,12 +690,13 @@ def fresnel_cos(x, error_check=True):
     else:
         pass
 
+    x = np.asarray(x)
+    if np.isrealobj(x) or (not np.any(np.imag(x))):
+        return _fresnel_cs(np.real(x))[0]
+
     f_cos = ((0.25-0.25j)*erf((1.0+1.0j)*x*SQRT_PI_2)+
              (0.25+0.25j)*erf((1.0-1.0j)*x*SQRT_PI_2))
 
-    if (np.isreal(x).all()):
-        f_cos = np.real(f_cos)
-
     return f_cos
 
 def fresnel_sin(x, error_check=True):
@@ -716,6 +720,8 @@ def fresnel_sin(x, error_check=True):
                 y = 2/sqrt(pi) * integral (t=0 to x) exp(-t^2)dt.
                 Using Euler's Formula for exponentials allows one
                 to use this to solve for the Fresnel Sine integral.
+                For real x, the compiled engine in native.py is used
+                instead when it has been built.
             [3] The Fresnel sine integral is used for the solution
                 of diffraction through a square well. Because of this
                 is is useful for forward modeling problems in 
@@ -757,14 +763,66 @@ def fresnel_sin(x, error_check=True):
     else:
         pass
 
+    x = np.asarray(x)
+    if np.isrealobj(x) or (not np.any(np.imag(x))):
+        return _fresnel_cs(np.real(x))[1]
+
     f_sin = ((0.25+0.25j)*erf((1.0+1.0j)*x*SQRT_PI_2)+
              (0.25-0.25j)*erf((1.0-1.0j)*x*SQRT_PI_2))
 
-    if (np.isreal(x).all()):
-        f_sin = np.real(f_sin)
-
     return f_sin
 
+def _fresnel_cs(x):
+    """
+        Purpose:
+            Compute the Fresnel cosine and sine integrals of a real
+            argument together, without checking the input. This is
+            used by fresnel_cos, fresnel_sin and sq_well_solve once
+            they have checked their own inputs.
+        Arguments:
+            :x (*np.ndarray* or *float*):
+                A real number, or real numpy array.
+        Outputs:
+            :f_cos (*np.ndarray*):
+                The Fresnel cosine integral of x.
+            :f_sin (*np.ndarray*):
+                The Fresnel sine integral of x.
+        Notes:
+            [1] If the compiled engine is available (see native.py)
+                both integrals come from a single C routine, which
+                uses the same convention as fresnel_cos and
+                fresnel_sin. Otherwise _fresnel_cs_erf is used.
+    """
+    x = np.real(x)
+    if native.NATIVE_AVAILABLE:
+        return native.fresnel_cs(x)
+
+    return _fresnel_cs_erf(x)
+
+def _fresnel_cs_erf(x):
+    """
+        Purpose:
+            Compute the Fresnel cosine and sine integrals of a real
+            argument with the scipy.special Error Function, as
+            fresnel_cos and fresnel_sin do for complex arguments.
+            This is the reference the compiled routine is checked
+            against (see examples/special_functions_validation.py).
+        Arguments:
+            :x (*np.ndarray* or *float*):
+                A real number, or real numpy array.
+        Outputs:
+            :f_cos (*np.ndarray*):
+                The Fresnel cosine integral of x.
+            :f_sin (*np.ndarray*):
+                The Fresnel sine integral of x.
+        Notes:
+            [1] For real x, Erf((1-i)x) is the complex conjugate of
+                Erf((1+i)x), so one Error Function call gives both
+                integrals.
+    """
+    f = erf((1.0+1.0j)*np.real(x)*SQRT_PI_2)
+    return 0.5*(np.real(f)+np.imag(f)), 0.5*(np.real(f)-np.imag(f))
+
 def single_slit_diffraction(x, z, a):
     """
         Purpose:
@@ -837,7 +895,8 @@ def single_slit_diffraction(x, z, a):
             % (type(a).__name__)
             )
 
-    f = np.sinc(a*x/z)*np.sinc(a*x/z)
+    f = np.sinc(a*x/z)
+    f *= f
     return f
 
 def double_slit_diffraction(x, z, a, d):
@@ -1018,8 +1077,10 @@ def sq_well_solve(x, a, b, F, invert=False):
     else:
         pass
 
-    H = (0.5 - 0.5j) * (fresnel_cos((b-x)/F)-fresnel_cos((a-x)/F)+
-                        1j*(fresnel_sin((b-x) / F)-fresnel_sin((a-x)/F)))
+    # The inputs are checked above, so the integrals skip the checks.
+    C_b, S_b = _fresnel_cs((b-x)/F)
+    C_a, S_a = _fresnel_cs((a-x)/F)
+    H = (0.5 - 0.5j) * (C_b - C_a + 1j*(S_b - S_a))
 
     if not invert:
         H = 1-H
@@ -0,0 +1,649 @@
+/*
+ *  Purpose:
+ *      Compiled Fresnel inversion engine for rss_ringoccs. This is a
+ *      line-by-line translation of DiffractionCorrection.__ftrans in
+ *      diffrec/diffraction_correction.py. The Python loop is kept as the
+ *      reference implementation and the arithmetic here is written in
+ *      the same order so that both agree to round-off.
+ *
+ *      The range of points is split into chunks that are reconstructed
+ *      on a pool of POSIX threads. Every output point is computed from
+ *      the same window and the same arithmetic regardless of the chunk
+ *      it lands in, so the output is bit-identical for any number of
+ *      threads.
+ *
+ *      References:
+ *          [MTR1986] Marouf, Tyler, Rosen (1986), Icarus 68, 120-166.
+ */
+
+/*  Needed for pthreads when compiling with -std=c99.  */
+#define _POSIX_C_SOURCE 200809L
+
+#include <math.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <pthread.h>
+#include "diffraction_functions.h"
+
+/*  Declare constants for multiples of pi and the square root of 2.  */
+#define HALF_PI 1.570796326794896619231322
+#define SQRT_2 1.414213562373095048801689
+
+/*  Coefficients of the fresnel3...fresnel8 expansions of psi.  */
+typedef struct {
+    double b[7];
+    double C[7];
+    int n_terms;
+} psi_coeffs;
+
+/*  A_2 coefficient from the Legendre expansion of psi.  */
+static double rss_A2(double B, double phi)
+{
+    double cosb = cos(B);
+    double sinp = sin(phi);
+    return 0.5*cosb*cosb*sinp*sinp/(1.0-cosb*cosb*sinp*sinp);
+}
+
+/*
+ *  Legendre polynomials and their products for the point with ring
+ *  opening angle B and azimuth angle phi. Each psitype has slightly
+ *  different expressions in the Python source, reproduced here as is.
+ */
+static void rss_legendre_coeffs(int psitype, double B, double phi,
+                                psi_coeffs *c)
+{
+    double P_1, P12, P_2, P_3, P_4, P_5, P_6;
+    double cosb = cos(B);
+    double cosp = cos(phi);
+
+    P_1 = cosb*cosp;
+    P12 = P_1*P_1;
+    P_2 = (3.0*P12-1.0)*0.5;
+
+    switch (psitype) {
+        case RSS_PSI_FRESNEL3:
+            c->b[0] = (1.0-P12)*0.5;
+            c->b[1] = (P_1-P_1*P_2)/3.0;
+            c->C[0] = P12;
+            c->C[1] = 2.0*P_1*P_2;
+            c->n_terms = 2;
+            break;
+        case RSS_PSI_FRESNEL4:
+            P_3 = (5.0*P12-3.0)*0.5*P_1;
+            c->C[0] = P_1*P_1;
+            c->C[1] = 2.0*P_1*P_2;
+            c->C[2] = P_2*P_2;
+            c->b[0] = (1.0-P12)*0.5;
+            c->b[1] = (P_1-P_1*P_2)/3.0;
+            c->b[2] = (P_2-P_1*P_3)*0.25;
+            c->n_terms = 3;
+            break;
+        case RSS_PSI_FRESNEL6:
+            P_3 = (5.0*P12-3.0)*0.5*P_1;
+            P_4 = (35.0*P12*P12-30.0*P12+3.0)/8.0;
+            P_5 = P_1*(63.0*P12*P12-70.0*P12+15.0)/8.0;
+            c->b[0] = (1.0-P12)*0.5;
+            c->b[1] = (P_1-P_1*P_2)/3.0;
+            c->b[2] = (P_2-P_1*P_3)*0.25;
+            c->b[3] = (P_3-P_1*P_4)*0.2;
+            c->b[4] = (P_4-P_1*P_5)/6.0;
+            c->C[0] = P_1*P_1;
+            c->C[1] = 2.0*P_1*P_2;
+            c->C[2] = P_2*P_2+2.0*P_1*P_3;
+            c->C[3] = 2.0*P_2*P_3;
+            c->C[4] = P_3*P_3;
+            c->n_terms = 5;
+            break;
+        default:
+            P_3 = P_1*(5.0*P12-3.0)*0.5;
+            P_4 = (35.0*P12*P12-30.0*P12+3.0)/8.0;
+            P_5 = P_1*(63.0*P12*P12-70.0*P12+15.0)/8.0;
+            P_6 = (231.0*P12*P12*P12-315.0*P12*P12+105.0*P12-5.0)/16.0;
+            c->C[0] = P_1*P_1;
+            c->C[1] = 2.0*P_1*P_2;
+            c->C[2] = 2.0*P_1*P_3+P_2*P_2;
+            c->C[3] = 2.0*P_1*P_4+2.0*P_2*P_3;
+            c->C[4] = 2.0*P_2*P_4+P_3*P_3;
+            c->C[5] = 2.0*P_3*P_4;
+            c->C[6] = P_4*P_4;
+            c->b[0] = (1.0-P12)/2.0;
+            c->b[1] = (P_1-P_1*P_2)/3.0;
+            c->b[2] = (P_2-P_1*P_3)/4.0;
+            c->b[3] = (P_3-P_1*P_4)/5.0;
+            c->b[4] = (P_4-P_1*P_5)/6.0;
+            c->b[5] = (P_5-P_1*P_4)/7.0;
+            c->b[6] = (P_6-P_1*P_5)/8.0;
+            c->n_terms = 7;
+            break;
+    }
+}
+
+/*  Geometric psi function (MTR86 Equation 4). Signs of xi are swapped.  */
+static double rss_psi(double kD, double r, double r0, double phi,
+                      double phi0, double B, double D)
+{
+    double xi = (cos(B)/D) * (r * cos(phi) - r0 * cos(phi0));
+    double eta = (r0*r0 + r*r - 2.0*r*r0*cos(phi-phi0)) / (D*D);
+    return kD * (sqrt(1.0+eta-2.0*xi) + xi - 1.0);
+}
+
+/*
+ *  First and second partial derivatives of psi with respect to phi,
+ *  sharing the trigonometric terms.
+ */
+static void rss_dpsi_d2psi(double kD, double r, double r0, double phi,
+                           double phi0, double B, double D,
+                           double *psi_d1, double *psi_d2)
+{
+    double cos_phi = cos(phi);
+    double sin_phi = sin(phi);
+    double cos_dphi = cos(phi-phi0);
+    double sin_dphi = sin(phi-phi0);
+    double rcpr_D2 = 1.0/(D*D);
+    double cb_D = cos(B)/D;
+    double xi = cb_D * (r * cos_phi - r0 * cos(phi0));
+    double eta = (r0*r0 + r*r - 2.0*r*r0*cos_dphi) * rcpr_D2;
+    double rcpr_psi0 = 1.0/sqrt(1.0+eta-2.0*xi);
+    double dxi = -cb_D * (r*sin_phi);
+    double dxi2 = -cb_D * (r*cos_phi);
+    double deta = 2.0*r*r0*sin_dphi*rcpr_D2;
+    double deta2 = 2.0*r*r0*cos_dphi*rcpr_D2;
+    double u = deta-2.0*dxi;
+
+    *psi_d1 = kD*(0.5*rcpr_psi0*u + dxi);
+    *psi_d2 = -0.25*rcpr_psi0*rcpr_psi0*rcpr_psi0*u*u;
+    *psi_d2 += 0.5*rcpr_psi0*(deta2-2.0*dxi2) + dxi2;
+    *psi_d2 *= kD;
+}
+
+/*
+ *  Compute psi across the window for one point. x holds rho[center]-r0
+ *  as evaluated when the window was last reset, which is what the
+ *  Python loop reuses while it slides crange along the data.
+ *
+ *  With z = x/D, the fresnel3...fresnel8 expansions are
+ *
+ *      psi = kD z^2 sum_k (b_k - A_2 C_k) z^k.
+ *
+ *  The factors kD/D^(k+2) are folded into the coefficients once per
+ *  point, so the sum is a polynomial in x that is evaluated with
+ *  Horner's scheme in a single pass over the window. For fresnel6 and
+ *  fresnel8, A_2 varies across the window and the b_k and C_k sums are
+ *  evaluated side by side.
+ */
+static void rss_window_psi(int psitype, long center, long first, long nw,
+                           const double *x, const double *F,
+                           const double *D, const double *B,
+                           const double *phi, const double *kD,
+                           const double *A_2, double *psi)
+{
+    long j;
+    int k, n;
+    double F2, A2c, scale, p_b, p_C, x1;
+    double a_b[7], a_C[7];
+    psi_coeffs c = {{0.0}, {0.0}, 0};
+
+    if (psitype == RSS_PSI_FRESNEL) {
+        F2 = F[center]*F[center];
+        for (j = 0; j < nw; ++j)
+            psi[j] = (HALF_PI * x[j] * x[j]) / F2;
+        return;
+    }
+
+    rss_legendre_coeffs(psitype, B[center], phi[center], &c);
+    n = c.n_terms;
+
+    /*  Coefficients of x^(k+2), with kD and the powers of D folded in.  */
+    scale = kD[center]/(D[center]*D[center]);
+    for (k = 0; k < n; ++k) {
+        a_b[k] = c.b[k]*scale;
+        a_C[k] = c.C[k]*scale;
+        scale /= D[center];
+    }
+
+    if ((psitype == RSS_PSI_FRESNEL3) || (psitype == RSS_PSI_FRESNEL4)) {
+        A2c = A_2[center];
+        for (k = 0; k < n; ++k)
+            a_b[k] -= A2c*a_C[k];
+
+        for (j = 0; j < nw; ++j) {
+            x1 = x[j];
+            p_b = a_b[n-1];
+            for (k = n-2; k >= 0; --k)
+                p_b = p_b*x1 + a_b[k];
+            psi[j] = p_b*x1*x1;
+        }
+    }
+    else {
+        /*  fresnel6 and fresnel8 index A_2 across the window.  */
+        for (j = 0; j < nw; ++j) {
+            x1 = x[j];
+            p_b = a_b[n-1];
+            p_C = a_C[n-1];
+            for (k = n-2; k >= 0; --k) {
+                p_b = p_b*x1 + a_b[k];
+                p_C = p_C*x1 + a_C[k];
+            }
+            psi[j] = (p_b - A_2[first + j]*p_C)*x1*x1;
+        }
+    }
+}
+
+/*
+ *  Stationary phase solution and psi for the 'full' psitype. Each
+ *  element takes Newton-Raphson steps until |dpsi/dphi| <= RSS_NEWTON_TOL
+ *  or it has taken RSS_NEWTON_MAX steps. If warm is non-zero, phi_s holds
+ *  the solution for the previous point, with azimuth angle phi0_prev,
+ *  and is used as the starting guess. Returns the largest number of
+ *  steps taken by any element.
+ */
+static int rss_window_psi_full(long center, long first, long nw,
+                               const double *rho, const double *D,
+                               const double *B, const double *phi,
+                               const double *kD, int warm, double phi0_prev,
+                               double *phi_s, double *psi)
+{
+    long j;
+    int loop, max_loop;
+    double r = rho[center];
+    double d = D[center];
+    double b = B[center];
+    double phi0 = phi[center];
+    double psi_d1, psi_d2;
+
+    max_loop = 0;
+    for (j = 0; j < nw; ++j) {
+        /*  Start from the previous solution, moved to this point.  */
+        if (warm)
+            phi_s[j] += phi0 - phi0_prev;
+        else
+            phi_s[j] = phi0;
+
+        for (loop = 0; loop < RSS_NEWTON_MAX; ++loop) {
+            rss_dpsi_d2psi(kD[first+j], r, rho[first+j], phi_s[j], phi0,
+                           b, d, &psi_d1, &psi_d2);
+            if (fabs(psi_d1) <= RSS_NEWTON_TOL)
+                break;
+
+            /*  Newton-Raphson.  */
+            phi_s[j] -= psi_d1 / psi_d2;
+        }
+
+        if (loop > max_loop)
+            max_loop = loop;
+
+        psi[j] = rss_psi(kD[first+j], r, rho[first+j], phi_s[j], phi0, b, d);
+    }
+
+    return max_loop;
+}
+
+void rss_window_sum(const double *psi, const double *w_func,
+                    const double complex *T, long n, double sign,
+                    double complex *sum_ker, double complex *sum_T)
+{
+    long j, j0, nb;
+    double k_re, k_im, ker_re, ker_im, T_re, T_im;
+    double sin_psi[RSS_SINCOS_BLOCK], cos_psi[RSS_SINCOS_BLOCK];
+
+    ker_re = 0.0;
+    ker_im = 0.0;
+    T_re = 0.0;
+    T_im = 0.0;
+    for (j0 = 0; j0 < n; j0 += RSS_SINCOS_BLOCK) {
+        nb = (n - j0 < RSS_SINCOS_BLOCK) ? n - j0 : RSS_SINCOS_BLOCK;
+        rss_sincos(psi + j0, sign, nb, sin_psi, cos_psi);
+        for (j = 0; j < nb; ++j) {
+            k_re = w_func[j0+j]*cos_psi[j];
+            k_im = w_func[j0+j]*sin_psi[j];
+            ker_re += k_re;
+            ker_im += k_im;
+            T_re += k_re*creal(T[j0+j]) - k_im*cimag(T[j0+j]);
+            T_im += k_re*cimag(T[j0+j]) + k_im*creal(T[j0+j]);
+        }
+    }
+    *sum_ker = ker_re + I*ker_im;
+    *sum_T = T_re + I*T_im;
+}
+
+/*  Read-only description of one transform, shared by all threads.  */
+typedef struct {
+    const double *rho;
+    const double complex *T_in;
+    const double *F;
+    const double *w;
+    const double *D;
+    const double *B;
+    const double *phi;
+    const double *kD;
+    const double *A_2;
+    double dx;
+    double sign;
+    long n_pts;
+    long start;
+    long n_used;
+    long nw_max;
+    int wtype;
+    int psitype;
+    int norm;
+    int canonical;
+    double complex *T_out;
+    long *iter_hist;
+
+    /*  Points at which the serial loop recomputes the window.  */
+    const long *resets;
+    long n_resets;
+
+    /*  Chunk scheduling. next_chunk and status are guarded by lock.  */
+    long chunk_size;
+    long n_chunks;
+    long next_chunk;
+    int status;
+    pthread_mutex_t lock;
+} rss_transform_ctx;
+
+/*  Scratch arrays owned by a single thread.  */
+typedef struct {
+    double *w_func;
+    double *x;
+    double *psi;
+    double *phi_s;
+
+    /*  Newton-Raphson step counts for the points of this thread.  */
+    long iter_hist[RSS_NEWTON_MAX+1];
+} rss_workspace;
+
+static int rss_workspace_alloc(rss_workspace *ws, long nw_max)
+{
+    int k;
+
+    for (k = 0; k <= RSS_NEWTON_MAX; ++k)
+        ws->iter_hist[k] = 0;
+
+    ws->w_func = malloc(sizeof(*ws->w_func)*nw_max);
+    ws->x = malloc(sizeof(*ws->x)*nw_max);
+    ws->psi = malloc(sizeof(*ws->psi)*nw_max);
+    ws->phi_s = malloc(sizeof(*ws->phi_s)*nw_max);
+    if (!ws->w_func || !ws->x || !ws->psi || !ws->phi_s)
+        return RSS_ERR_NO_MEMORY;
+    return RSS_SUCCESS;
+}
+
+static void rss_workspace_free(rss_workspace *ws)
+{
+    free(ws->w_func);
+    free(ws->x);
+    free(ws->psi);
+    free(ws->phi_s);
+}
+
+/*  Set the window state to the one left by the reset at center.  */
+static long rss_reset_window(const rss_transform_ctx *ctx, rss_workspace *ws,
+                             long center)
+{
+    long j, nw, half_nw;
+
+    if (ctx->canonical)
+        nw = rss_window_canonical(ctx->wtype,
+                                  rss_window_size(ctx->w[center], ctx->dx),
+                                  ctx->dx, ws->w_func);
+    else
+        nw = rss_window(ctx->wtype, ctx->w[center], ctx->dx, ws->w_func);
+    half_nw = (nw-1)/2;
+    if ((center - half_nw < 0) || (center + half_nw >= ctx->n_pts))
+        return RSS_ERR_BAD_RANGE;
+
+    for (j = 0; j < nw; ++j)
+        ws->x[j] = ctx->rho[center] - ctx->rho[center - half_nw + j];
+    return nw;
+}
+
+/*
+ *  Reconstruct the points [c0, c1). The window state at c0 is rebuilt
+ *  from the last reset at or before c0, so every point sees exactly the
+ *  window, and the x values, that the serial loop would have used. The
+ *  halo of a chunk is the half window on either side of its points,
+ *  which is read directly from the shared T_in array.
+ */
+static int rss_transform_chunk(const rss_transform_ctx *ctx,
+                               rss_workspace *ws, long c0, long c1)
+{
+    long lo, hi, mid, center, first, nw, half_nw;
+    int warm, loop;
+    double w_init, T1;
+    double complex sum_ker, sum_T, T;
+    const double complex *T_in = ctx->T_in;
+    const double dx = ctx->dx;
+
+    /*  Binary search for the last reset at or before c0.  */
+    lo = 0;
+    hi = ctx->n_resets - 1;
+    while (lo < hi) {
+        mid = (lo + hi + 1)/2;
+        if (ctx->resets[mid] <= c0)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    w_init = ctx->w[ctx->resets[lo]];
+    nw = rss_reset_window(ctx, ws, ctx->resets[lo]);
+    if (nw < 0)
+        return (int)nw;
+    half_nw = (nw-1)/2;
+
+    /*  Chunks start on a multiple of RSS_NEWTON_BLOCK, solved cold.  */
+    warm = 0;
+
+    for (center = c0; center < c1; ++center) {
+        if (fabs(w_init - ctx->w[center]) >= 2.0 * dx) {
+            /*  Reset w_init and recompute window function.  */
+            w_init = ctx->w[center];
+            nw = rss_reset_window(ctx, ws, center);
+            if (nw < 0)
+                return (int)nw;
+            half_nw = (nw-1)/2;
+            warm = 0;
+        }
+
+        if ((center - ctx->start) % RSS_NEWTON_BLOCK == 0)
+            warm = 0;
+
+        first = center - half_nw;
+        if ((first < 0) || (center + half_nw >= ctx->n_pts))
+            return RSS_ERR_BAD_RANGE;
+
+        if (ctx->psitype == RSS_PSI_FULL) {
+            loop = rss_window_psi_full(center, first, nw, ctx->rho, ctx->D,
+                                       ctx->B, ctx->phi, ctx->kD, warm,
+                                       (warm) ? ctx->phi[center-1] : 0.0,
+                                       ws->phi_s, ws->psi);
+            ws->iter_hist[loop] += 1;
+            warm = 1;
+        }
+        else
+            rss_window_psi(ctx->psitype, center, first, nw, ws->x, ctx->F,
+                           ctx->D, ctx->B, ctx->phi, ctx->kD, ctx->A_2,
+                           ws->psi);
+
+        /*  Weighted sum of the data against the Fresnel kernel.  */
+        rss_window_sum(ws->psi, ws->w_func, T_in + first, nw, ctx->sign,
+                       &sum_ker, &sum_T);
+
+        /*  Compute 'approximate' Fresnel Inversion for current point.  */
+        if (ctx->psitype == RSS_PSI_FRESNEL)
+            T = sum_T*dx*(0.5+0.5*I)/ctx->F[center];
+        else
+            T = sum_T*dx*(1.0+1.0*I)/(2.0*ctx->F[center]);
+
+        /*  If normalization has been set, normalize the reconstruction.  */
+        if (ctx->norm) {
+            T1 = cabs(sum_ker * dx);
+            T *= SQRT_2 * ctx->F[center] / T1;
+        }
+
+        ctx->T_out[center] = T;
+    }
+    return RSS_SUCCESS;
+}
+
+/*
+ *  Thread body. Chunks are handed out one at a time from a shared
+ *  counter, so threads that land on the wide windows of the inner
+ *  rings simply take fewer chunks while the others keep working.
+ */
+static void *rss_transform_worker(void *arg)
+{
+    rss_transform_ctx *ctx = arg;
+    rss_workspace ws;
+    long chunk, c0, c1;
+    int k, status;
+
+    status = rss_workspace_alloc(&ws, ctx->nw_max);
+    while (status == RSS_SUCCESS) {
+        pthread_mutex_lock(&ctx->lock);
+        if ((ctx->status != RSS_SUCCESS) || (ctx->next_chunk >= ctx->n_chunks))
+            chunk = -1;
+        else
+            chunk = ctx->next_chunk++;
+        pthread_mutex_unlock(&ctx->lock);
+
+        if (chunk < 0)
+            break;
+
+        c0 = ctx->start + chunk*ctx->chunk_size;
+        c1 = c0 + ctx->chunk_size;
+        if (c1 > ctx->start + ctx->n_used)
+            c1 = ctx->start + ctx->n_used;
+
+        status = rss_transform_chunk(ctx, &ws, c0, c1);
+    }
+
+    pthread_mutex_lock(&ctx->lock);
+    if (status != RSS_SUCCESS)
+        ctx->status = status;
+    for (k = 0; k <= RSS_NEWTON_MAX; ++k)
+        ctx->iter_hist[k] += ws.iter_hist[k];
+    pthread_mutex_unlock(&ctx->lock);
+
+    rss_workspace_free(&ws);
+    return NULL;
+}
+
+int
+rss_fresnel_transform(const double *rho, const double complex *T_in,
+                      const double *F, const double *w, const double *D,
+                      const double *B, const double *phi, const double *kD,
+                      double dx, long n_pts, long start, long n_used,
+                      int wtype, int psitype, int norm, int fwd,
+                      int nthreads, int canonical, double complex *T_out,
+                      long *iter_hist)
+{
+    long i, center, n_spawned;
+    double w_init, w_max;
+    double *A_2 = NULL;
+    long *resets = NULL;
+    pthread_t *threads = NULL;
+    rss_transform_ctx ctx;
+
+    if ((wtype < RSS_WINDOW_RECT) || (wtype > RSS_WINDOW_KBMD25))
+        return RSS_ERR_BAD_WINDOW;
+    if ((psitype < RSS_PSI_FRESNEL) || (psitype > RSS_PSI_FULL))
+        return RSS_ERR_BAD_PSITYPE;
+    if ((start < 0) || (n_used <= 0) || (start + n_used > n_pts))
+        return RSS_ERR_BAD_RANGE;
+    if (nthreads < 1)
+        nthreads = 1;
+
+    A_2 = malloc(sizeof(*A_2)*n_pts);
+    resets = malloc(sizeof(*resets)*n_used);
+    if (!A_2 || !resets) {
+        free(A_2);
+        free(resets);
+        return RSS_ERR_NO_MEMORY;
+    }
+
+    if ((psitype != RSS_PSI_FRESNEL) && (psitype != RSS_PSI_FULL)) {
+        for (i = 0; i < n_pts; ++i)
+            A_2[i] = rss_A2(B[i], phi[i]);
+    }
+
+    /*
+     *  Serial pre-pass over the window widths only. This records each
+     *  point where the Python loop recomputes the window, which makes
+     *  the result independent of how the range is split into chunks.
+     */
+    w_init = w[start];
+    w_max = w[start];
+    ctx.n_resets = 1;
+    resets[0] = start;
+    for (i = 0; i < n_used; ++i) {
+        center = start + i;
+        if (fabs(w_init - w[center]) >= 2.0 * dx) {
+            w_init = w[center];
+            resets[ctx.n_resets++] = center;
+        }
+        if (w_init > w_max)
+            w_max = w_init;
+    }
+
+    ctx.rho = rho;
+    ctx.T_in = T_in;
+    ctx.F = F;
+    ctx.w = w;
+    ctx.D = D;
+    ctx.B = B;
+    ctx.phi = phi;
+    ctx.kD = kD;
+    ctx.A_2 = A_2;
+    ctx.dx = dx;
+    ctx.sign = (fwd) ? 1.0 : -1.0;
+    ctx.n_pts = n_pts;
+    ctx.start = start;
+    ctx.n_used = n_used;
+    ctx.nw_max = rss_window_size(w_max, dx);
+    ctx.wtype = wtype;
+    ctx.psitype = psitype;
+    ctx.norm = norm;
+    ctx.canonical = canonical;
+    ctx.T_out = T_out;
+    ctx.iter_hist = iter_hist;
+    ctx.resets = resets;
+
+    /*  Several chunks per thread so that the load can be balanced.  */
+    ctx.chunk_size = n_used/(16*(long)nthreads) + 1;
+
+    /*  Warm starts restart at the same points for any number of threads.  */
+    if (psitype == RSS_PSI_FULL)
+        ctx.chunk_size = RSS_NEWTON_BLOCK *
+            ((ctx.chunk_size + RSS_NEWTON_BLOCK - 1)/RSS_NEWTON_BLOCK);
+    ctx.n_chunks = (n_used + ctx.chunk_size - 1)/ctx.chunk_size;
+    ctx.next_chunk = 0;
+    ctx.status = RSS_SUCCESS;
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    /*  The calling thread is a worker too.  */
+    n_spawned = 0;
+    if (nthreads > 1) {
+        threads = malloc(sizeof(*threads)*(nthreads-1));
+        if (threads) {
+            while (n_spawned < nthreads-1) {
+                if (pthread_create(&threads[n_spawned], NULL,
+                                   rss_transform_worker, &ctx) != 0)
+                    break;
+                ++n_spawned;
+            }
+        }
+    }
+
+    rss_transform_worker(&ctx);
+
+    for (i = 0; i < n_spawned; ++i)
+        pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&ctx.lock);
+    free(threads);
+    free(resets);
+    free(A_2);
+    return ctx.status;
+}
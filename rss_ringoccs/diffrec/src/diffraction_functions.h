@@ -0,0 +1,131 @@
+/*
+ *  Purpose:
+ *      Declarations for the compiled diffraction reconstruction engine
+ *      used by rss_ringoccs.diffrec.DiffractionCorrection. The routines
+ *      declared here mirror the Python implementation of the Fresnel
+ *      inversion found in diffraction_correction.py and are accessed
+ *      from Python through the ctypes binding in diffrec/native.py.
+ *
+ *      All arrays are contiguous double precision. Complex arrays are
+ *      stored as interleaved (real, imaginary) pairs, which is the
+ *      memory layout of both C99 double complex and numpy complex128.
+ */
+
+#ifndef RSS_RINGOCCS_DIFFRACTION_FUNCTIONS_H
+#define RSS_RINGOCCS_DIFFRACTION_FUNCTIONS_H
+
+#include <complex.h>
+
+/*  Window types. The order MUST match WINDOW_TYPES in diffrec/native.py.  */
+enum rss_window_type {
+    RSS_WINDOW_RECT = 0,
+    RSS_WINDOW_COSS = 1,
+    RSS_WINDOW_KB20 = 2,
+    RSS_WINDOW_KB25 = 3,
+    RSS_WINDOW_KB35 = 4,
+    RSS_WINDOW_KBMD20 = 5,
+    RSS_WINDOW_KBMD25 = 6
+};
+
+/*  Psi types. The order MUST match PSI_TYPES in diffrec/native.py.  */
+enum rss_psi_type {
+    RSS_PSI_FRESNEL = 0,
+    RSS_PSI_FRESNEL3 = 1,
+    RSS_PSI_FRESNEL4 = 2,
+    RSS_PSI_FRESNEL6 = 3,
+    RSS_PSI_FRESNEL8 = 4,
+    RSS_PSI_FULL = 5
+};
+
+/*  Error codes returned by the engine.  */
+#define RSS_SUCCESS 0
+#define RSS_ERR_BAD_WINDOW -1
+#define RSS_ERR_BAD_PSITYPE -2
+#define RSS_ERR_BAD_RANGE -3
+#define RSS_ERR_NO_MEMORY -4
+
+/*
+ *  Newton-Raphson settings for psitype 'full'. These MUST match
+ *  NEWTON_TOL, NEWTON_MAX and NEWTON_BLOCK in diffraction_correction.py.
+ */
+#define RSS_NEWTON_TOL 1.0e-4
+#define RSS_NEWTON_MAX 6
+#define RSS_NEWTON_BLOCK 256
+
+/*  Points per block of sines and cosines in rss_window_sum.  */
+#define RSS_SINCOS_BLOCK 256
+
+/*  Modified Bessel function of the first kind, order zero.  */
+extern double rss_bessel_I0(double x);
+
+/*  Number of points in a window of width w_in with spacing dx.  */
+extern long rss_window_size(double w_in, double dx);
+
+/*  Compute the requested tapering function into w_func.  */
+extern long rss_window(int wtype, double w_in, double dx, double *w_func);
+
+/*
+ *  Kaiser-Bessel window I_0(alpha*sqrt(1-4x^2))/I_0(alpha) for a given
+ *  alpha or, if modified is non-zero, the modified window, which is
+ *  shifted by one so that it is zero at the endpoints. These are kbal
+ *  and kbmdal from window_functions.py, where alpha is al*pi.
+ */
+extern long rss_window_kbal(double alpha, int modified, double w_in,
+                            double dx, double *w_func);
+
+/*
+ *  Same as rss_window, but evaluated at the canonical width nw_pts*dx
+ *  used by the Python WindowCache, so that the taper only depends on
+ *  the number of points in the window.
+ */
+extern long rss_window_canonical(int wtype, long nw_pts, double dx,
+                                 double *w_func);
+
+/*
+ *  Fresnel integrals of real x in the convention of fresnel_cos and
+ *  fresnel_sin in special_functions.py, C[j] = integral (t=0 to u)
+ *  cos(pi/2 t^2) dt and S[j] = integral (t=0 to u) sin(pi/2 t^2) dt
+ *  with u = sqrt(2) x[j], for j < n. See special_functions.c.
+ */
+extern void rss_fresnel_cs(const double *x, long n, double *C, double *S);
+
+/*
+ *  sin_x[j] = sin(sign*x[j]) and cos_x[j] = cos(sign*x[j]) for j < n.
+ *  The loop is vectorized, and on x86-64 the widest instruction set
+ *  the CPU supports is picked at load time. See sincos.c.
+ */
+extern void rss_sincos(const double *x, double sign, long n,
+                       double *sin_x, double *cos_x);
+
+/*
+ *  Weighted sums over one window of n points: sum_ker is the sum of
+ *  w_func*exp(i*sign*psi) and sum_T the sum of w_func*exp(i*sign*psi)*T.
+ *  The kernel is formed a block of RSS_SINCOS_BLOCK points at a time
+ *  and never stored.
+ */
+extern void rss_window_sum(const double *psi, const double *w_func,
+                           const double complex *T, long n, double sign,
+                           double complex *sum_ker, double complex *sum_T);
+
+/*
+ *  Compute the Fresnel inversion (fwd = 0) or the Fresnel transform
+ *  (fwd = 1) of T_in for the points [start, start + n_used) and store
+ *  the result in T_out. The arrays rho, F, w, D, B, phi and kD all
+ *  have n_pts elements. Windows continue to be recomputed only when
+ *  the window width drifts by 2*dx, exactly as in the Python loop.
+ *  The work is shared between nthreads threads; the output does not
+ *  depend on nthreads. If canonical is non-zero, the windows are built
+ *  with rss_window_canonical. For psitype 'full', iter_hist[k] is
+ *  incremented for every point whose stationary phase took k Newton-
+ *  Raphson steps; iter_hist has RSS_NEWTON_MAX+1 elements.
+ */
+extern int
+rss_fresnel_transform(const double *rho, const double complex *T_in,
+                      const double *F, const double *w, const double *D,
+                      const double *B, const double *phi, const double *kD,
+                      double dx, long n_pts, long start, long n_used,
+                      int wtype, int psitype, int norm, int fwd,
+                      int nthreads, int canonical, double complex *T_out,
+                      long *iter_hist);
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ *  Purpose:
+ *      Sine and cosine of an array, used by the native Fresnel inversion
+ *      engine for the kernel exp(+/- i psi). The loop has no branches and
+ *      no calls into libm, so the compiler can vectorize it. On x86-64
+ *      Linux with GCC, AVX-512 and AVX2 versions are built next to the
+ *      baseline one and the fastest that the CPU supports is picked when
+ *      the library is loaded. On AArch64, NEON is part of the baseline
+ *      and is used directly. The arithmetic is the same in every version,
+ *      so the result does not depend on which one runs.
+ *
+ *      The argument is reduced to [-pi/4, pi/4] with a three-part
+ *      Cody-Waite reduction and the sine and cosine of the remainder are
+ *      computed with the minimax polynomials of fdlibm (k_sin.c, k_cos.c),
+ *      which are accurate to about 1 ulp. Arguments larger in magnitude
+ *      than RSS_SINCOS_MAX fall back to sin and cos from libm.
+ */
+
+#include <math.h>
+#include "diffraction_functions.h"
+
+#if defined(__GNUC__) && !defined(__clang__) && \
+    defined(__x86_64__) && defined(__linux__)
+#define RSS_TARGET_CLONES \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define RSS_TARGET_CLONES
+#endif
+
+/*  2/pi, and pi/2 split into three parts of 33 bits.  */
+#define TWO_BY_PI 6.36619772367581382433e-01
+#define PIO2_1 1.57079632673412561417e+00
+#define PIO2_2 6.07710050630396597660e-11
+#define PIO2_3 2.02226624871116645580e-21
+
+/*  Adding and subtracting 1.5*2^52 rounds to the nearest integer.  */
+#define ROUND_MAGIC 6755399441055744.0
+
+/*  Largest argument for which k*PIO2_1 is exact.  */
+#define RSS_SINCOS_MAX 1.0e6
+
+/*  Coefficients of the sine and cosine kernels from fdlibm.  */
+#define S1 -1.66666666666666324348e-01
+#define S2 8.33333333332248946124e-03
+#define S3 -1.98412698298579493134e-04
+#define S4 2.75573137070700676789e-06
+#define S5 -2.50507602534068634195e-08
+#define S6 1.58969099521155010221e-10
+
+#define C1 4.16666666666666019037e-02
+#define C2 -1.38888888888741095749e-03
+#define C3 2.48015872894767294178e-05
+#define C4 -2.75573143513906633035e-07
+#define C5 2.08757232129817482790e-09
+#define C6 -1.13596475577881948265e-11
+
+RSS_TARGET_CLONES
+void rss_sincos(const double * restrict x, double sign, long n,
+                double * restrict sin_x, double * restrict cos_x)
+{
+    long j;
+    int odd;
+    double xj, k, q, r, z, v, hz, w, s_r, c_r, s_j, c_j;
+
+    for (j = 0; j < n; ++j) {
+        xj = sign*x[j];
+
+        /*  xj = k pi/2 + r with |r| <= pi/4, and the quadrant q.  */
+        k = (xj*TWO_BY_PI + ROUND_MAGIC) - ROUND_MAGIC;
+        r = ((xj - k*PIO2_1) - k*PIO2_2) - k*PIO2_3;
+
+        /*  k mod 4 in {-2, -1, 0, 1, 2}, without floor, which does not
+         *  vectorize under strict ISO C.  */
+        q = k - 4.0*((0.25*k + ROUND_MAGIC) - ROUND_MAGIC);
+
+        /*  Sine and cosine of r.  */
+        z = r*r;
+        v = z*r;
+        s_r = r + v*(S1 + z*(S2 + z*(S3 + z*(S4 + z*(S5 + z*S6)))));
+        hz = 0.5*z;
+        w = 1.0 - hz;
+        c_r = w + (((1.0 - w) - hz) +
+                   z*z*(C1 + z*(C2 + z*(C3 + z*(C4 + z*(C5 + z*C6))))));
+
+        /*  Rotate by the quadrant with selects rather than branches.
+         *  sin is negative for q in {-2, -1, 2}, cos for q in {-2, 1, 2}.  */
+        odd = (fabs(q) == 1.0);
+        s_j = odd ? c_r : s_r;
+        c_j = odd ? s_r : c_r;
+        sin_x[j] = (fabs(q - 0.5) > 1.0) ? -s_j : s_j;
+        cos_x[j] = (fabs(q + 0.5) > 1.0) ? -c_j : c_j;
+    }
+
+    /*  The reduction loses accuracy for very large arguments.  */
+    for (j = 0; j < n; ++j) {
+        if (fabs(x[j]) > RSS_SINCOS_MAX) {
+            sin_x[j] = sin(sign*x[j]);
+            cos_x[j] = cos(sign*x[j]);
+        }
+    }
+}
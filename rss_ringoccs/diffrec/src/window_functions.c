@@ -0,0 +1,130 @@
+/*
+ *  Purpose:
+ *      Compiled versions of the tapering functions defined in
+ *      diffrec/window_functions.py, used by the native Fresnel
+ *      inversion engine. Each routine reproduces the Python
+ *      expression term for term so that the two agree to round-off.
+ */
+
+#include <math.h>
+#include "diffraction_functions.h"
+
+/*  Declare constants for multiples of pi.  */
+#define TWO_PI 6.283185307179586476925287
+#define ONE_PI 3.141592653589793238462643
+
+/*  Declare constants for various Bessel function inputs (I_0(x)).  */
+#define IV0_20 87.10850209627940
+#define IV0_25 373.02058499037486
+#define IV0_35 7257.7994923041760
+
+/*
+ *  The power series I_0(x) = sum (x/2)^2k / (k!)^2 has only positive
+ *  terms, so for the arguments used by the Kaiser-Bessel windows
+ *  (0 <= x <= 3.5 pi) summing until the terms are negligible is
+ *  accurate to a few ulp. Larger alpha, as in rss_window_kbal, only
+ *  takes more terms.
+ */
+double rss_bessel_I0(double x)
+{
+    double y = 0.25*x*x;
+    double term = 1.0;
+    double sum = 1.0;
+    double k = 1.0;
+
+    while (term > 1.0e-17*sum) {
+        term *= y/(k*k);
+        sum += term;
+        k += 1.0;
+    }
+    return sum;
+}
+
+/*  Window functions have an odd number of points.  */
+long rss_window_size(double w_in, double dx)
+{
+    return (long)(2.0 * floor(w_in / (2.0 * dx)) + 1.0);
+}
+
+/*  Kaiser-Bessel and modified Kaiser-Bessel windows.  */
+static long rss_kaiser_bessel(double alpha, double shift, double norm,
+                              double w_in, double dx, double *w_func)
+{
+    long n, nw_pts = rss_window_size(w_in, dx);
+    double center = (nw_pts - 1) / 2.0;
+    double x;
+
+    for (n = 0; n < nw_pts; ++n) {
+        x = ((double)n - center) * dx / w_in;
+        w_func[n] = (rss_bessel_I0(alpha*sqrt(1.0 - 4.0*x*x)) - shift)/norm;
+    }
+    return nw_pts;
+}
+
+long rss_window(int wtype, double w_in, double dx, double *w_func)
+{
+    long n, nw_pts = rss_window_size(w_in, dx);
+    double center = (nw_pts - 1) / 2.0;
+    double x, alpha, norm, shift;
+
+    switch (wtype) {
+        case RSS_WINDOW_RECT:
+            for (n = 0; n < nw_pts; ++n)
+                w_func[n] = 1.0;
+            return nw_pts;
+        case RSS_WINDOW_COSS:
+            for (n = 0; n < nw_pts; ++n) {
+                x = ONE_PI * ((double)n - center) * dx / w_in;
+                w_func[n] = cos(x)*cos(x);
+            }
+            return nw_pts;
+        case RSS_WINDOW_KB20:
+            alpha = TWO_PI;
+            norm = IV0_20;
+            shift = 0.0;
+            break;
+        case RSS_WINDOW_KB25:
+            alpha = 2.5 * ONE_PI;
+            norm = IV0_25;
+            shift = 0.0;
+            break;
+        case RSS_WINDOW_KB35:
+            alpha = 3.5 * ONE_PI;
+            norm = IV0_35;
+            shift = 0.0;
+            break;
+        case RSS_WINDOW_KBMD20:
+            alpha = TWO_PI;
+            norm = IV0_20 - 1.0;
+            shift = 1.0;
+            break;
+        case RSS_WINDOW_KBMD25:
+            alpha = 2.5 * ONE_PI;
+            norm = IV0_25 - 1.0;
+            shift = 1.0;
+            break;
+        default:
+            return RSS_ERR_BAD_WINDOW;
+    }
+
+    return rss_kaiser_bessel(alpha, shift, norm, w_in, dx, w_func);
+}
+
+long rss_window_kbal(double alpha, int modified, double w_in, double dx,
+                     double *w_func)
+{
+    double shift = (modified ? 1.0 : 0.0);
+    return rss_kaiser_bessel(alpha, shift, rss_bessel_I0(alpha) - shift,
+                             w_in, dx, w_func);
+}
+
+long rss_window_canonical(int wtype, long nw_pts, double dx, double *w_func)
+{
+    double w_in = (double)nw_pts*dx;
+
+    /*  Guard against rounding in nw_pts*dx changing the size.  */
+    if (rss_window_size(w_in, dx) != nw_pts)
+        w_in = ((double)nw_pts + 0.5)*dx;
+
+    return rss_window(wtype, w_in, dx, w_func);
+}
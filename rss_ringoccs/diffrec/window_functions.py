@@ -2,14 +2,21 @@
     Purpose:
         Provide a suite of window functions and
         functions related to the normalized equivalent
-        width of a given array.
+        width of a given array. When the compiled engine has
+        been built (see native.py), the Kaiser-Bessel windows
+        are computed by it rather than with scipy.special.iv.
     Dependencies:
         #. numpy
         #. spicy
+        #. os
+        #. threading
 """
 
+import os
+import threading
 import numpy as np
 from scipy.special import lambertw, iv
+from . import native
 
 # Declare constants for multiples of pi.
 TWO_PI = 6.283185307179586476925287
@@ -278,6 +285,10 @@ def kb20(w_in, dx, error_check=True):
         else:
             pass
 
+    # The compiled engine sums the series for I_0 in C.
+    if native.NATIVE_AVAILABLE:
+        return native.window("kb20", w_in, dx)
+
     # Window functions have an odd number of points.
     nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -374,6 +385,9 @@ def kb25(w_in, dx, error_check=True):
         else:
             pass
 
+    if native.NATIVE_AVAILABLE:
+        return native.window("kb25", w_in, dx)
+
     # Window functions have an odd number of points.
     nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -473,6 +487,9 @@ def kb35(w_in, dx, error_check=True):
         else:
             pass
 
+    if native.NATIVE_AVAILABLE:
+        return native.window("kb35", w_in, dx)
+
     # Window functions have an odd number of points.
     nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -579,6 +596,9 @@ def kbmd20(w_in, dx, error_check=True):
         else:
             pass
 
+    if native.NATIVE_AVAILABLE:
+        return native.window("kbmd20", w_in, dx)
+
     # Window functions have an odd number of points.
     nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -682,6 +702,9 @@ def kbmd25(w_in, dx, error_check=True):
         else:
             pass
 
+    if native.NATIVE_AVAILABLE:
+        return native.window("kbmd25", w_in, dx)
+
     # Window functions have an odd number of points.
     nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -811,6 +834,9 @@ def kbal(w_in, dx, al, error_check=True):
         else:
             pass
 
+    if native.NATIVE_AVAILABLE:
+        return native.window("kbal", w_in, dx, alpha=al * ONE_PI)
+
     # Window functions have an odd number of points.
     nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -936,6 +962,9 @@ def kbmdal(w_in, dx, al, error_check=True):
         else:
             pass
 
+    if native.NATIVE_AVAILABLE:
+        return native.window("kbmdal", w_in, dx, alpha=al * ONE_PI)
+
     # Window functions have an odd number of points.
     nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
 
@@ -1249,4 +1278,247 @@ func_dict = {
     "kb35":   {"func": kb35,   "normeq": 1.92844639},
     "kbmd20": {"func": kbmd20, "normeq": 1.52048174},
     "kbmd25": {"func": kbmd25, "normeq": 1.65994218}
-}
\ No newline at end of file
+}
+
+class WindowCache(object):
+    """
+        Purpose:
+            Process-wide cache of tapering functions. Windows are
+            keyed on (wtype, alpha, nw_pts, dx) and evaluated at the
+            canonical width nw_pts*dx, so every request for a window
+            with the same number of points returns the same array.
+            Optionally, windows are also stored on disk as .npy
+            files so that they persist across processes and across
+            Revs. Each file is written to a temporary file first and
+            then renamed, so that processes sharing cache_dir never
+            read a partly written window. The cache can be used by
+            several threads at once, e.g. the ingress and egress
+            reconstructions of e2e_batch.py.
+        Keywords:
+            :cache_dir (*str*):
+                Directory for the on-disk cache. If None, which is
+                the default, windows are only cached in memory.
+        Attributes:
+            :hits (*int*):
+                Number of requests served from memory.
+            :disk_hits (*int*):
+                Number of requests served from cache_dir.
+            :misses (*int*):
+                Number of windows that had to be computed.
+        Notes:
+            [1] Since the window is evaluated at nw_pts*dx rather
+                than the exact requested width, the taper of a window
+                of width w_in differs from func_dict[wtype](w_in, dx)
+                by less than one sample in width. This is smaller
+                than the 2*dx drift DiffractionCorrection already
+                allows before recomputing a window.
+            [2] The free-space normalization of the Fresnel kernel
+                depends on psi, and hence on the geometry, not just
+                on the window, so it is not cached.
+        Examples:
+            Get a kbmd20 window of 101 points with spacing 0.25 km
+            and print the cache counters.
+                In [1]: from rss_ringoccs.diffrec import window_functions
+                In [2]: wc = window_functions.window_cache
+                In [3]: w = wc.get("kbmd20", 101, 0.25)
+                In [4]: print(wc.stats())
+    """
+    def __init__(self, cache_dir=None):
+        self.__lock = threading.RLock()
+        self.__cache = {}
+        self.hits = 0
+        self.disk_hits = 0
+        self.misses = 0
+        self.cache_dir = None
+        if cache_dir is not None:
+            self.set_cache_dir(cache_dir)
+
+    def set_cache_dir(self, cache_dir):
+        """
+            Purpose:
+                Enable (or with None, disable) the on-disk cache.
+            Arguments:
+                :cache_dir (*str*):
+                    Directory in which windows are stored. It is
+                    created if it does not exist.
+        """
+        if cache_dir is not None:
+            if not os.path.isdir(cache_dir):
+                os.makedirs(cache_dir)
+        self.cache_dir = cache_dir
+
+    def __key(self, wtype, nw_pts, dx, alpha):
+        if not (wtype in func_dict) and not (wtype in ["kbal", "kbmdal"]):
+            raise ValueError(
+                "\n\tError Encountered:\n"
+                "\trss_ringoccs: diffrec Subpackage\n"
+                "\twindow_functions.WindowCache:\n"
+                "\t\tIllegal window type: %s\n" % (wtype)
+            )
+        elif (wtype in ["kbal", "kbmdal"]) and (alpha is None):
+            raise ValueError(
+                "\n\tError Encountered:\n"
+                "\trss_ringoccs: diffrec Subpackage\n"
+                "\twindow_functions.WindowCache:\n"
+                "\t\t%s requires the alpha keyword.\n" % (wtype)
+            )
+        elif (int(nw_pts) % 2 != 1) or (int(nw_pts) < 1):
+            raise ValueError(
+                "\n\tError Encountered:\n"
+                "\trss_ringoccs: diffrec Subpackage\n"
+                "\twindow_functions.WindowCache:\n"
+                "\t\tnw_pts must be a positive odd integer.\n"
+                "\t\tYour input: %d\n" % (int(nw_pts))
+            )
+        elif (wtype in func_dict):
+            alpha = None
+        else:
+            alpha = float(alpha)
+
+        return (wtype, alpha, int(nw_pts), float(dx))
+
+    def __compute(self, key):
+        wtype, alpha, nw_pts, dx = key
+        w_in = nw_pts*dx
+        if (alpha is None):
+            w_func = func_dict[wtype]["func"](w_in, dx, error_check=False)
+        elif (wtype == "kbal"):
+            w_func = kbal(w_in, dx, alpha, error_check=False)
+        else:
+            w_func = kbmdal(w_in, dx, alpha, error_check=False)
+
+        # Guard against rounding in nw_pts*dx changing the size.
+        if (np.size(w_func) != nw_pts):
+            w_in = (nw_pts + 0.5)*dx
+            if (alpha is None):
+                w_func = func_dict[wtype]["func"](w_in, dx, error_check=False)
+            elif (wtype == "kbal"):
+                w_func = kbal(w_in, dx, alpha, error_check=False)
+            else:
+                w_func = kbmdal(w_in, dx, alpha, error_check=False)
+
+        return w_func
+
+    def __file(self, key):
+        wtype, alpha, nw_pts, dx = key
+        return os.path.join(self.cache_dir, "%s_%r_%d_%r.npy"
+                            % (wtype, alpha, nw_pts, dx))
+
+    def get(self, wtype, nw_pts, dx, alpha=None):
+        """
+            Purpose:
+                Return the cached window, computing it if needed.
+            Arguments:
+                :wtype (*str*):
+                    Window type. Any key of func_dict, or 'kbal'
+                    and 'kbmdal' with the alpha keyword.
+                :nw_pts (*int*):
+                    Number of points in the window. Must be odd.
+                :dx (*float*):
+                    Spacing between points in the window.
+            Keywords:
+                :alpha (*float*):
+                    Alpha parameter for 'kbal' and 'kbmdal'.
+            Outputs:
+                :w_func (*np.ndarray*):
+                    The window. This is shared between all callers
+                    and is read-only.
+        """
+        key = self.__key(wtype, nw_pts, dx, alpha)
+        with self.__lock:
+            return self.__get(key)
+
+    def __get(self, key):
+        if key in self.__cache:
+            self.hits += 1
+            return self.__cache[key]
+
+        w_func = None
+        if self.cache_dir is not None:
+            fname = self.__file(key)
+            if os.path.isfile(fname):
+                try:
+                    w_func = np.load(fname)
+                    self.disk_hits += 1
+                except (IOError, OSError, ValueError):
+                    w_func = None
+
+        if w_func is None:
+            self.misses += 1
+            w_func = self.__compute(key)
+            if self.cache_dir is not None:
+                fname = self.__file(key)
+                tmp = '%s.%d.tmp' % (fname, os.getpid())
+                try:
+                    with open(tmp, 'wb') as f:
+                        np.save(f, w_func)
+                    os.replace(tmp, fname)
+                except (IOError, OSError):
+                    try:
+                        os.remove(tmp)
+                    except OSError:
+                        pass
+
+        w_func.flags.writeable = False
+        self.__cache[key] = w_func
+        return w_func
+
+    def window(self, wtype, w_in, dx, alpha=None):
+        """
+            Purpose:
+                Return the cached window for a window of width w_in.
+                This is a drop in for func_dict[wtype]["func"].
+            Arguments:
+                :wtype (*str*):
+                    Window type.
+                :w_in (*float*):
+                    Window width.
+                :dx (*float*):
+                    Spacing between points in the window.
+            Keywords:
+                :alpha (*float*):
+                    Alpha parameter for 'kbal' and 'kbmdal'.
+            Outputs:
+                :w_func (*np.ndarray*):
+                    The cached window with the same number of
+                    points as a window of width w_in.
+        """
+        nw_pts = int(2 * np.floor(w_in / (2.0 * dx)) + 1)
+        return self.get(wtype, nw_pts, dx, alpha=alpha)
+
+    def stats(self):
+        """
+            Purpose:
+                Return the cache counters as a dictionary.
+        """
+        with self.__lock:
+            return {
+                "hits": self.hits,
+                "disk_hits": self.disk_hits,
+                "misses": self.misses,
+                "size": len(self.__cache)
+            }
+
+    def clear(self):
+        """
+            Purpose:
+                Empty the in-memory cache and reset the counters.
+                Files in cache_dir are left untouched.
+        """
+        with self.__lock:
+            self.__cache = {}
+            self.reset_stats()
+
+    def reset_stats(self):
+        """
+            Purpose:
+                Reset the counters, e.g. at the start of each file
+                of a batch, and keep the cached windows.
+        """
+        with self.__lock:
+            self.hits = 0
+            self.disk_hits = 0
+            self.misses = 0
+
+# Process-wide window cache.
+window_cache = WindowCache()
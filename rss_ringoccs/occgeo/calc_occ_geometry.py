@@ -6,6 +6,10 @@
     useful geometry information, such as free-space regions and planetary
     occultation times.
 
+    SPICE is called once per epoch, and the results are kept as
+    contiguous Nx3 arrays so that norms, frame rotations, and angles are
+    computed with array operations rather than one vector at a time.
+
 :Dependencies:
     #. spiceypy
     #. numpy
@@ -14,6 +18,98 @@
 import spiceypy as spice
 import numpy as np
 from scipy.interpolate import interp1d
+from ..tools.spice_session import kernel_session
+from ..tools import instrument
+
+def spkpos_batch(targ, et_vals, ref, abcorr, obs):
+    """
+    Purpose:
+        Compute the position of a target relative to an observer at every
+        epoch in et_vals with a single call to spiceypy.spkpos.
+
+    Arguments:
+        :targ (*str*): Target name -- must be compatible with NAIF.
+        :et_vals (*float* or *np.ndarray*): Epochs in ET seconds.
+        :ref (*str*): Reference frame of the output vectors.
+        :abcorr (*str*): Aberration correction flag.
+        :obs (*str*): Observer name -- must be compatible with NAIF.
+
+    Returns:
+        :starg_vals (*np.ndarray*): Nx3 array of position vectors in km.
+        :ltime_vals (*np.ndarray*): Array of one-way light times in sec.
+    """
+    et_vals = np.atleast_1d(np.asarray(et_vals, dtype=float))
+    starg, ltime = spice.spkpos(targ, et_vals, ref, abcorr, obs)
+    starg_vals = np.ascontiguousarray(np.reshape(starg, (-1, 3)), dtype=float)
+    ltime_vals = np.reshape(np.asarray(ltime, dtype=float), -1)
+    return starg_vals, ltime_vals
+
+def vhat_batch(vecs):
+    """
+    Purpose:
+        Unit vectors along each row of an Nx3 array. Zero vectors are
+        returned unchanged, as in spiceypy.vhat.
+
+    Arguments:
+        :vecs (*np.ndarray*): Nx3 array of vectors.
+
+    Returns:
+        :uvecs (*np.ndarray*): Nx3 array of unit vectors.
+    """
+    vecs = np.asarray(vecs, dtype=float)
+    norms = np.linalg.norm(vecs, axis=-1)
+    norms = np.where(norms == 0., 1., norms)
+    return vecs / norms[..., np.newaxis]
+
+def vsep_batch(v1, v2):
+    """
+    Purpose:
+        Angle between the rows of two arrays of vectors, using the same
+        numerically stable formulas as spiceypy.vsep.
+
+    Arguments:
+        :v1 (*np.ndarray*): Nx3 array of vectors.
+        :v2 (*np.ndarray*): Nx3 array of vectors, or a single 3-vector.
+
+    Returns:
+        :sep_rad (*np.ndarray*): Array of angles in radians.
+    """
+    u1 = vhat_batch(v1)
+    u2 = vhat_batch(np.broadcast_to(v2, np.shape(u1)))
+    dot = np.sum(u1 * u2, axis=-1)
+    sep_pos = 2. * np.arcsin(0.5 * np.linalg.norm(u1 - u2, axis=-1))
+    sep_neg = np.pi - 2. * np.arcsin(0.5 * np.linalg.norm(u1 + u2, axis=-1))
+    return np.where(dot > 0., sep_pos, sep_neg)
+
+def mxv_batch(mat, vecs):
+    """
+    Purpose:
+        Multiply each row of an Nx3 array of vectors by a 3x3 matrix, or
+        by the matching matrix of an Nx3x3 array.
+
+    Arguments:
+        :mat (*np.ndarray*): 3x3 or Nx3x3 array of matrices.
+        :vecs (*np.ndarray*): Nx3 array of vectors.
+
+    Returns:
+        :out_vecs (*np.ndarray*): Nx3 array of rotated vectors.
+    """
+    return np.einsum('...ij,...j->...i', mat, vecs)
+
+def ra_batch(vecs):
+    """
+    Purpose:
+        Right ascension of each row of an Nx3 array, in [0, 2pi), as
+        returned by spiceypy.recrad.
+
+    Arguments:
+        :vecs (*np.ndarray*): Nx3 array of vectors.
+
+    Returns:
+        :ra_rad (*np.ndarray*): Array of right ascensions in radians.
+    """
+    ra_rad = np.arctan2(vecs[..., 1], vecs[..., 0])
+    return np.where(ra_rad < 0., ra_rad + 2.*np.pi, ra_rad)
 
 def calc_B_deg(et_vals, spacecraft, dsn, nhat_p, kernels=None):
     """
@@ -34,9 +130,7 @@ def calc_B_deg(et_vals, spacecraft, dsn, nhat_p, kernels=None):
         :B_deg_vals (*np.ndarray*): Array of ring opening angle in degrees.
     """
 
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
     try:
         npts = len(et_vals)
     except TypeError:
@@ -45,24 +139,18 @@ def calc_B_deg(et_vals, spacecraft, dsn, nhat_p, kernels=None):
         et_vals.append(et)
         npts = len(et_vals)
 
-    B_deg_vals = np.zeros(npts)
-
-    for n in range(npts):
-        # Compute Cassini to dsn position vector
-        targ = dsn
-        et = et_vals[n]
-        ref = 'J2000'
-        abcorr = 'CN'
-        obs = spacecraft
-        starg, ltime = spice.spkpos(targ, et, ref, abcorr, obs)
+    # Compute Cassini to dsn position vector
+    targ = dsn
+    ref = 'J2000'
+    abcorr = 'CN'
+    obs = spacecraft
+    starg, ltime = spkpos_batch(targ, et_vals, ref, abcorr, obs)
 
-        # Calculate B as the complement to the angle made by the
-        #   Saturn pole vector and the Cassini to DSN vector
-        v1 = starg
-        v2 = nhat_p
-        B_rad = (np.pi/2.) - spice.vsep(v1, v2)
+    # Calculate B as the complement to the angle made by the
+    #   Saturn pole vector and the Cassini to DSN vector
+    B_rad_vals = (np.pi/2.) - vsep_batch(starg, np.asarray(nhat_p))
 
-        B_deg_vals[n] = B_rad * spice.dpr()
+    B_deg_vals = B_rad_vals * spice.dpr()
 
     return B_deg_vals
 
@@ -166,33 +254,25 @@ def calc_elevation_deg(et_vals, target, obs, kernels=None):
     Returns:
         :elev_deg_vals (*np.ndarray*): Array of elevation angles in degrees.
     """
-    npts = len(et_vals)
-    elev_deg_vals = np.zeros(npts)
-
     # Load kernels
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
-
-    for n in range(npts):
-        et = et_vals[n]
+    kernel_session.load(kernels)
 
-        # Compute observer to target position vector in J2000
-        #   with light-correction
-        ref = obs + '_TOPO'
-        abcorr = 'CN'
-        ptarg1, ltime1 = spice.spkpos(target, et, ref, abcorr, obs)
+    # Compute observer to target position vector in J2000
+    #   with light-correction
+    ref = obs + '_TOPO'
+    abcorr = 'CN'
+    ptarg1, ltime1 = spkpos_batch(target, et_vals, ref, abcorr, obs)
 
-        # Compute Earth to observer position vector in J2000
-        #   without light correction
-        abcorr = 'NONE'
-        planet = 'EARTH'
+    # Compute Earth to observer position vector in J2000
+    #   without light correction
+    abcorr = 'NONE'
+    planet = 'EARTH'
 
-        ptarg2, ltime2 = spice.spkpos(obs, et, ref, abcorr, planet)
+    ptarg2, ltime2 = spkpos_batch(obs, et_vals, ref, abcorr, planet)
 
-        # Calculate elevation as the complement to the angle
-        #   between ptarg1 (obs->target) and ptarg2 (Earth->obs)
-        elev_deg_vals[n] = 90. - spice.vsep(ptarg1, ptarg2)*spice.dpr()
+    # Calculate elevation as the complement to the angle
+    #   between ptarg1 (obs->target) and ptarg2 (Earth->obs)
+    elev_deg_vals = 90. - vsep_batch(ptarg1, ptarg2)*spice.dpr()
 
     return elev_deg_vals
 
@@ -203,8 +283,8 @@ def calc_impact_radius_km(R_sc_km_vals, et_vals, spacecraft, dsn, nhat_p,
     planet defined as a sphere.
 
     Arguments:
-        :R_sc_km_vals (*list*): List of 3-element arrays of spacecraft
-            position vector in planetocentric frame at input et_vals.
+        :R_sc_km_vals (*np.ndarray*): Nx3 array of spacecraft position
+            vectors in planetocentric frame at input et_vals.
         :et_vals (*np.ndarray*): Array of Earth-received times in ephemeris
             seconds.
         :spacecraft (*str*): Spacecraft name
@@ -218,36 +298,30 @@ def calc_impact_radius_km(R_sc_km_vals, et_vals, spacecraft, dsn, nhat_p,
         :R_imp_km_vals (*np.ndarray*): Array of impact radius in km.
     """
 
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
-    npts = len(et_vals)
-    R_imp_km_vals = np.zeros(npts)
-
-    for n in range(npts):
-        R_sc_km = R_sc_km_vals[n]
-        et = et_vals[n]
-
-        # Compute spacecraft to dsn position vector in J2000 frame,
-        #   at et+ltime
-        targ = dsn
-        ref = 'J2000'
-        abcorr = 'XCN'
-        obs = spacecraft
-        starg1, ltime1 = spice.spkpos(targ, et, ref, abcorr, obs)
-
-        # Transform vector to planetocentric frame
-        R_sc2dsn_km_pcf = xform_j2k_to_pcf(starg1, et, spacecraft,
-                dsn, nhat_p)
-
-        # Calculate distance from saturn center to point of closest approach
-        lindir = R_sc2dsn_km_pcf
-        linpt = R_sc_km
-        point = [0., 0., 0.]
-        pnear, distance = spice.nplnpt(linpt, lindir, point)
-
-        R_imp_km_vals[n] = distance
+    R_sc_km_vals = np.reshape(np.asarray(R_sc_km_vals, dtype=float), (-1, 3))
+
+    # Compute spacecraft to dsn position vector in J2000 frame,
+    #   at et+ltime
+    targ = dsn
+    ref = 'J2000'
+    abcorr = 'XCN'
+    obs = spacecraft
+    starg1, ltime1 = spkpos_batch(targ, et_vals, ref, abcorr, obs)
+
+    # Transform vector to planetocentric frame
+    R_sc2dsn_km_pcf = xform_j2k_to_pcf(starg1, et_vals, spacecraft,
+            dsn, nhat_p)
+
+    # Calculate distance from saturn center to point of closest approach,
+    #   as spiceypy.nplnpt does: remove the component along the line
+    lindir = vhat_batch(R_sc2dsn_km_pcf)
+    linpt = R_sc_km_vals
+    proj = np.sum(linpt * lindir, axis=1)
+    pnear = linpt - proj[:, np.newaxis] * lindir
+
+    R_imp_km_vals = np.linalg.norm(pnear, axis=1)
     return R_imp_km_vals
 
 def calc_phi_deg(et_vals, rho_vec_km_vals, spacecraft, dsn, nhat_p,
@@ -274,54 +348,42 @@ def calc_phi_deg(et_vals, rho_vec_km_vals, spacecraft, dsn, nhat_p,
     Notes:
         #. phi_ora_deg differs from the [MTR1986]_ definition by 180 degrees.
     """
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
-
-    npts = len(et_vals)
-    phi_rl_deg_vals = np.zeros(npts)
-    phi_ora_deg_vals = np.zeros(npts)
-
-    for n in range(npts):
-        et = et_vals[n]
-
-        rho_vec_km = rho_vec_km_vals[n]
-
-        # Compute DSN to spacecraft position vector with light correction
-        targ = dsn
-        ref = 'J2000'
-        abcorr = 'CN'
-        obs = spacecraft
-        starg, ltime = spice.spkpos(targ, et, ref, abcorr, obs)
+    kernel_session.load(kernels)
 
-        # Rotate vector so that xy plane is in the ring plane
-        zaxis = [0., 0., 1.]
-        axdef = nhat_p
-        indexa = 3
-        plndef = zaxis
-        indexp = 2
+    rho_vec_km_vals = np.reshape(np.asarray(rho_vec_km_vals, dtype=float),
+            (-1, 3))
 
-        rotmat = spice.twovec(axdef, indexa, plndef, indexp)
-        vec_rl = spice.mxv(rotmat, rho_vec_km)
+    # Compute DSN to spacecraft position vector with light correction
+    targ = dsn
+    ref = 'J2000'
+    abcorr = 'CN'
+    obs = spacecraft
+    starg, ltime = spkpos_batch(targ, et_vals, ref, abcorr, obs)
 
-        # Convert coordinates to RA and DEC for inertial longitude
-        radius_vec_rl, ra_vec_rl, dec_vec_rl = spice.recrad(vec_rl)
+    # Rotate vector so that xy plane is in the ring plane. The rotation
+    #   only depends on the pole, so it is the same for every point
+    zaxis = [0., 0., 1.]
+    axdef = nhat_p
+    indexa = 3
+    plndef = zaxis
+    indexp = 2
 
-        phi_rl_deg = ra_vec_rl * spice.dpr()
-        phi_rl_deg_vals[n] = phi_rl_deg
+    rotmat = np.asarray(spice.twovec(axdef, indexa, plndef, indexp))
+    vec_rl = mxv_batch(rotmat, rho_vec_km_vals)
 
-        # Calculate observed ring azimuth by rotating pm to direction of
-        #   photon heading to observer
-        vec_ora = spice.mxv(rotmat, starg)
+    # Convert coordinates to RA for inertial longitude
+    phi_rl_deg_vals = ra_batch(vec_rl) * spice.dpr()
 
-        # Project vector onto ring plane
-        vec_ora[2] = 0
+    # Calculate observed ring azimuth by rotating pm to direction of
+    #   photon heading to observer. Only x and y are needed for RA, which
+    #   projects the vector onto the ring plane
+    vec_ora = mxv_batch(rotmat, starg)
 
-        # Convert coordinates to RA and DEC for ORA
-        radius_vec_ora, ra_vec_ora, dec_vec_ora = spice.recrad(vec_ora)
+    # Convert coordinates to RA for ORA
+    ra_vec_ora = ra_batch(vec_ora)
 
-        phi_ora_deg_vals[n] = (phi_rl_deg - ra_vec_ora*spice.dpr()
-                + 720.) % 360.
+    phi_ora_deg_vals = (phi_rl_deg_vals - ra_vec_ora*spice.dpr()
+            + 720.) % 360.
 
     return phi_rl_deg_vals, phi_ora_deg_vals
 
@@ -347,9 +409,9 @@ def calc_rho_km(et_vals, planet, spacecraft, dsn, kernels=None):
             kernels=kernels)
 
     # Compute magnitude of each vector
-    rho_km_vals = [spice.vnorm(vec) for vec in rho_vec_km]
+    rho_km_vals = np.linalg.norm(rho_vec_km, axis=1)
 
-    return np.asarray(rho_km_vals)
+    return rho_km_vals
 
 def calc_rho_vec_km(et_vals, planet, spacecraft, dsn, kernels=None,
         verbose=False):
@@ -368,7 +430,7 @@ def calc_rho_vec_km(et_vals, planet, spacecraft, dsn, kernels=None,
         :verbose (*bool*): Option for printing processing steps
 
     Output:
-        :rho_vec_km_vals (*list*): List of 3xN np.ndarrays of the planet
+        :rho_vec_km_vals (*np.ndarray*): Nx3 array of the planet
             center to ring intercept point position vector in J2000 frame
         :t_ret_et_vals (*np.ndarray*): Array of ring event times in ET seconds.
 
@@ -378,74 +440,65 @@ def calc_rho_vec_km(et_vals, planet, spacecraft, dsn, kernels=None,
 
     """
 
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     planet_id = spice.bodn2c(planet)
 
     npts = len(et_vals)
-    rho_vec_km_vals = []
+    spoint_vals = np.zeros((npts, 3))
+    xform_vals = np.zeros((npts, 3, 3))
     t_ret_et_vals = np.zeros(npts)
 
+    # Compute spacecraft position relative to dsn
+    targ = spacecraft
+    ref = 'J2000'
+    abcorr = 'CN'
+    obs = dsn
+    starg, ltime = spkpos_batch(targ, et_vals, ref, abcorr, obs)
+
+    nhat_sc2dsn = vhat_batch(starg)
+
+    iau_planet = 'IAU_'+planet.upper()
+
+    method = 'Ellipsoid'
+    target = planet
+    fixref = iau_planet
+    abcorr = 'CN'
+    obsrvr = dsn
+    dref = 'J2000'
+
     # Replace Saturn radii in kernel pool with values that represent a
     #   flat ellipsoid, which we will use as the ring plane
-    body = planet_id
-    item = 'RADII'
-    dim = 3
-    radii = spice.bodvcd(body, item, dim)
-
     new_radii = [1.e6, 1.e6, 1.e-5]
 
     # Construct naif radii code in form: 'BODY699_RADII'
     planet_naif_radii = 'BODY'+str(planet_id)+'_RADII'
 
-    name = planet_naif_radii
-    dvals = new_radii
-    spice.pdpool(name, dvals)
-
-    for n in range(npts):
-        et = et_vals[n]
-
-        # Compute spacecraft position relative to dsn
-        targ = spacecraft
-        ref = 'J2000'
-        abcorr = 'CN'
-        obs = dsn
-        starg, ltime, = spice.spkpos(targ, et, ref, abcorr, obs)
-
-        nhat_sc2dsn = spice.vhat(starg)
-
-        # Compute intersection of vector with ring plane and time epoch
-        #   of intersection in ET secs (ring event time)
-        iau_planet = 'IAU_'+planet.upper()
-
-        method = 'Ellipsoid'
-        target = planet
-        fixref = iau_planet
-        abcorr = 'CN'
-        obsrvr = dsn
-        dref = 'J2000'
-        dvec = nhat_sc2dsn
-        spoint, trgepc, srfvec = spice.sincpt(method, target, et,
-                fixref, abcorr, obsrvr, dref, dvec)
-
-        t_ret_et_vals[n] = trgepc
-
-        # Convert ring plane intercept to J2000 frame
-        frame_from = fixref
-        frame_to = dref
-        etfrom = trgepc
-        etto = et
-        xform = spice.pxfrm2(frame_from, frame_to, etfrom, etto)
-
-        rho_vec_km = spice.mxv(xform, spoint)
-        rho_vec_km_vals.append(rho_vec_km)
-
-    # Restore old original values of RADII to kernel pool
-    name = planet_naif_radii
-    dvals = radii[1].tolist()
-    spice.pdpool(name, dvals)
+    # The original radii are restored when leaving the with block
+    with kernel_session.pool_override(planet_naif_radii, new_radii), \
+            instrument.timer('occgeo.sincpt_loop'):
+        instrument.count('occgeo.sincpt_calls', npts)
+        for n in range(npts):
+            et = et_vals[n]
+
+            # Compute intersection of vector with ring plane and time epoch
+            #   of intersection in ET secs (ring event time)
+            dvec = nhat_sc2dsn[n]
+            spoint, trgepc, srfvec = spice.sincpt(method, target, et,
+                    fixref, abcorr, obsrvr, dref, dvec)
+
+            spoint_vals[n] = spoint
+            t_ret_et_vals[n] = trgepc
+
+            # Rotation from the ring plane intercept to J2000 frame
+            frame_from = fixref
+            frame_to = dref
+            etfrom = trgepc
+            etto = et
+            xform_vals[n] = spice.pxfrm2(frame_from, frame_to, etfrom, etto)
+
+    # Convert ring plane intercept to J2000 frame
+    rho_vec_km_vals = mxv_batch(xform_vals, spoint_vals)
 
     return rho_vec_km_vals, t_ret_et_vals
 
@@ -497,9 +550,9 @@ def calc_sc_state(et_vals, spacecraft, planet, dsn, nhat_p, kernels=None):
         :kernels (*str* or *list*): Path to NAIF kernel(s)
 
     Returns:
-        :R_sc_km_vals (*list*): List of Nx3 np.ndarrays of spacecraft position
+        :R_sc_km_vals (*np.ndarray*): Nx3 array of spacecraft position
             vector in km in planetocentric frame
-        :R_sc_dot_kms_vals (*list*): List of Nx3 np.ndarrays of spacecraft
+        :R_sc_dot_kms_vals (*np.ndarray*): Nx3 array of spacecraft
             velocity vector in km/s.
 
     Notes:
@@ -508,35 +561,27 @@ def calc_sc_state(et_vals, spacecraft, planet, dsn, nhat_p, kernels=None):
             direction of Saturn's pole.
     """
 
-    if kernels:
-        spice.kclear()
-        for kernel in kernels:
-            spice.furnsh(kernel)
+    kernel_session.load(kernels)
 
-    npts = len(et_vals)
-    R_sc_km_vals = []
-    R_sc_dot_kms_vals = []
-    for n in range(npts):
-        et = et_vals[n]
-
-        # Compute planet to spacecraft state vector in J2000 frame,
-        #   with no light-time correction
-        targ = spacecraft
-        ref = 'J2000'
-        abcorr = 'NONE'
-        obs = planet
-        starg0, ltime0 = spice.spkezr(targ, et, ref, abcorr, obs)
-
-        R_sat2sc_km = starg0[0:3]
-        R_sat2sc_dot_kms = starg0[3:6]
-
-        # Transform vectors to planetocentric frame
-        R_sc_km = xform_j2k_to_pcf(R_sat2sc_km, et, spacecraft, dsn, nhat_p)
-        R_sc_dot_kms = xform_j2k_to_pcf(R_sat2sc_dot_kms, et,
-                spacecraft, dsn, nhat_p)
-
-        R_sc_km_vals.append(R_sc_km)
-        R_sc_dot_kms_vals.append(R_sc_dot_kms)
+    et_vals = np.atleast_1d(np.asarray(et_vals, dtype=float))
+
+    # Compute planet to spacecraft state vector in J2000 frame,
+    #   with no light-time correction
+    targ = spacecraft
+    ref = 'J2000'
+    abcorr = 'NONE'
+    obs = planet
+    starg0, ltime0 = spice.spkezr(targ, et_vals, ref, abcorr, obs)
+    starg0 = np.reshape(np.asarray(starg0, dtype=float), (-1, 6))
+
+    R_sat2sc_km = starg0[:, 0:3]
+    R_sat2sc_dot_kms = starg0[:, 3:6]
+
+    # Transform vectors to planetocentric frame. Both vectors share the
+    #   same rotation, so compute it once
+    R_sc_km_vals, R_sc_dot_kms_vals = xform_j2k_to_pcf(
+            np.stack((R_sat2sc_km, R_sat2sc_dot_kms)), et_vals, spacecraft,
+            dsn, nhat_p)
 
     return R_sc_km_vals, R_sc_dot_kms_vals
 
@@ -557,9 +602,7 @@ def calc_set_et(et_vals, spacecraft, dsn, kernels=None):
             in ET sec.
     """
 
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     # Convert spacecraft and dsn strings to NAIF integer codes
     sc_code = spice.bodn2c(spacecraft)
@@ -567,9 +610,11 @@ def calc_set_et(et_vals, spacecraft, dsn, kernels=None):
 
     # Use light travel time to calculate spacecraft event time
     t_set_et_vals = []
-    for et in et_vals:
-        set_et, ltime = spice.ltime(et, dsn_code, "<-", sc_code)
-        t_set_et_vals.append(set_et)
+    with instrument.timer('occgeo.ltime_loop'):
+        instrument.count('occgeo.ltime_calls', len(et_vals))
+        for et in et_vals:
+            set_et, ltime = spice.ltime(et, dsn_code, "<-", sc_code)
+            t_set_et_vals.append(set_et)
 
     return np.asarray(t_set_et_vals)
 
@@ -625,9 +670,7 @@ def find_gaps(t_ret_spm_vals, year, doy, rho_km_vals, phi_rl_deg_vals,
 
     """
 
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     # import tabulated info on gap geometry/orbits
     gaps = np.loadtxt('../tables/gap_orbital_elements.txt',
@@ -760,6 +803,7 @@ def rad_converge(t_ret_spm_vals, rho_km_vals, phi_rl_deg_vals, semimajor,
         # update number of iterations
         n += 1
 
+    instrument.count('occgeo.rad_converge_iterations', n)
     return radius_new
 
 
@@ -1029,9 +1073,7 @@ def get_planet_occ_times(et_vals, obs, planet, spacecraft, height_above=500.,
 
     """
 
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     npts = len(et_vals)
     et_blocked_vals = []
@@ -1044,20 +1086,23 @@ def get_planet_occ_times(et_vals, obs, planet, spacecraft, height_above=500.,
     # Add height_above kwd to account for atmosphere
     new_radii = [radius + height_above for radius in original_radii]
 
-    # Update kernel pool with new radii
+    # Update kernel pool with new radii, which are restored when leaving
+    #   the with block
     planet_naif_radii = 'BODY'+str(planet_code)+'_RADII'
-    spice.pdpool(planet_naif_radii, new_radii)
 
     iau_planet = 'IAU_' + planet.upper()
 
-    for n in range(npts):
-        et = et_vals[n]
-        # Determine occultation condition
-        occ_code = spice.occult(planet, 'ELLIPSOID', iau_planet,
-                spacecraft, 'POINT', ' ', 'CN', obs, et)
-        # Append to et_blocked_vals if not partially or fully occulted
-        if occ_code != 0:
-            et_blocked_vals.append(et)
+    with kernel_session.pool_override(planet_naif_radii, new_radii), \
+            instrument.timer('occgeo.occult_loop'):
+        instrument.count('occgeo.occult_calls', npts)
+        for n in range(npts):
+            et = et_vals[n]
+            # Determine occultation condition
+            occ_code = spice.occult(planet, 'ELLIPSOID', iau_planet,
+                    spacecraft, 'POINT', ' ', 'CN', obs, et)
+            # Append to et_blocked_vals if not partially or fully occulted
+            if occ_code != 0:
+                et_blocked_vals.append(et)
 
     return np.asarray(et_blocked_vals)
 
@@ -1082,9 +1127,7 @@ def get_pole(et, planet, kernels=None):
     """
 
     # Load kernels
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     # Retrieve right ascension and declination from kernel pool
     bodynm = planet
@@ -1118,8 +1161,10 @@ def xform_j2k_to_pcf(vec, et, spacecraft, dsn, nhat_p, kernels=None):
         Transform vector in J2000 frame to planet ring plane frame.
 
     Arguments:
-        :vec (*np.ndarray*): 3-element vector in J2000 frame
-        :et (*float*): ET in seconds corresponding to input vec
+        :vec (*np.ndarray*): 3-element vector in J2000 frame, an Nx3 array
+            of vectors, or a stack of Nx3 arrays sharing the same epochs
+        :et (*float* or *np.ndarray*): ET in seconds corresponding to input
+            vec, with one epoch per row
         :dsn (*str*): DSN observing station ID
         :nhat_p (*np.ndarray*): 1x3 array unit vector in planet pole direction.
 
@@ -1127,19 +1172,18 @@ def xform_j2k_to_pcf(vec, et, spacecraft, dsn, nhat_p, kernels=None):
         :kernels (*str* or *list*): Path to NAIF kernels
 
     Returns:
-        :out_vec (*np.ndarray*): 3-element vector in planet ring plane frame.
+        :out_vec (*np.ndarray*): Vector(s) in planet ring plane frame, with
+            the same shape as vec.
     """
 
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     # Compute Cassini (at et) to dsn position vector (at et+ltime)
     targ = dsn
     ref = 'J2000'
     abcorr = 'XCN'
     obs = spacecraft
-    starg1, ltime1 = spice.spkpos(targ, et, ref, abcorr, obs)
+    starg1, ltime1 = spkpos_batch(targ, et, ref, abcorr, obs)
 
     # Rotate z-axis to planet pole direction
     zaxis = [0., 0., 1.]
@@ -1148,17 +1192,20 @@ def xform_j2k_to_pcf(vec, et, spacecraft, dsn, nhat_p, kernels=None):
     indexa = 3
     plndef = zaxis
     index = 2
-    rotmat_z = spice.twovec(axdef, indexa, plndef, index)
-    vec_z = spice.mxv(rotmat_z, vec)
-    R_sc2dsn_km_z = spice.mxv(rotmat_z, starg1)
-
-    # Rotate xaxis to Cassini to dsn direction
-    nhat_sc2dsn = R_sc2dsn_km_z/np.linalg.norm(R_sc2dsn_km_z)
-    nhat_sc2dsn[2] = 0.
-
-    rot_angle = np.arctan2(nhat_sc2dsn[1], nhat_sc2dsn[0])
-    rot_mat_sc2dsn = spice.rotate(rot_angle, 3)
-
-    out_vec = spice.mxv(rot_mat_sc2dsn, vec_z)
-
-    return out_vec
+    rotmat_z = np.asarray(spice.twovec(axdef, indexa, plndef, index))
+    vec = np.asarray(vec, dtype=float)
+    vec_z = mxv_batch(rotmat_z, np.reshape(vec, (-1, np.size(et), 3)))
+    R_sc2dsn_km_z = mxv_batch(rotmat_z, starg1)
+
+    # Rotate xaxis to Cassini to dsn direction. This is the rotation
+    #   spiceypy.rotate(rot_angle, 3) about the z-axis
+    rot_angle = np.arctan2(R_sc2dsn_km_z[:, 1], R_sc2dsn_km_z[:, 0])
+    cos_rot = np.cos(rot_angle)
+    sin_rot = np.sin(rot_angle)
+
+    out_vec = np.empty(np.shape(vec_z))
+    out_vec[..., 0] = cos_rot*vec_z[..., 0] + sin_rot*vec_z[..., 1]
+    out_vec[..., 1] = -sin_rot*vec_z[..., 0] + cos_rot*vec_z[..., 1]
+    out_vec[..., 2] = vec_z[..., 2]
+
+    return np.reshape(out_vec, np.shape(vec))
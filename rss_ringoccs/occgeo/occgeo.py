@@ -26,6 +26,7 @@ from ..tools.spm_to_et import spm_to_et
 from ..tools.et_to_spm import et_to_spm
 from ..tools.write_output_files import write_output_files
 from ..tools.history import write_history_dict
+from ..tools.spice_session import kernel_session
 
 from . import calc_occ_geometry as cog
 
@@ -135,6 +136,26 @@ class Geometry(object):
             raise ValueError('ERROR (Geometry): Input pt_per_sec is NOT an int '
                                 + 'or float!')
 
+        # Load kernels once for every step below, and always release
+        #   them, so that an error does not leave them loaded
+        load_time_start = kernel_session.load_time
+        kernel_session.acquire(kernels)
+        try:
+            self.__compute(rsr_inst, planet, spacecraft, kernels,
+                    pt_per_sec, verbose, load_time_start)
+        finally:
+            kernel_session.release()
+
+        # Write output data and label file if set
+        if write_file:
+            write_output_files(self)
+
+    def __compute(self, rsr_inst, planet, spacecraft, kernels, pt_per_sec,
+            verbose, load_time_start):
+        """
+        Compute every attribute of the geometry, with the kernels
+        loaded by __init__.
+        """
         if verbose:
             print('\tExtracting information from rsr file...')
 
@@ -162,7 +183,7 @@ class Geometry(object):
         rho_vec_vals, t_ret_et_vals = cog.calc_rho_vec_km(t_oet_et_vals, planet,
                 spacecraft, dsn, kernels=kernels)
 
-        rho_km_vals = [spice.vnorm(vec) for vec in rho_vec_vals]
+        rho_km_vals = np.linalg.norm(rho_vec_vals, axis=1)
 
 
 
@@ -267,12 +288,12 @@ class Geometry(object):
         self.phi_rl_dot_kms_vals = np.asarray(phi_rl_dot_kms_vals)
         self.F_km_vals = np.asarray(F_km_vals)
         self.R_imp_km_vals = np.asarray(R_imp_km_vals)
-        self.rx_km_vals = np.stack(R_sc_km_vals)[:, 0]
-        self.ry_km_vals = np.stack(R_sc_km_vals)[:, 1]
-        self.rz_km_vals = np.stack(R_sc_km_vals)[:, 2]
-        self.vx_kms_vals = np.stack(R_sc_dot_kms_vals)[:, 0]
-        self.vy_kms_vals = np.stack(R_sc_dot_kms_vals)[:, 1]
-        self.vz_kms_vals = np.stack(R_sc_dot_kms_vals)[:, 2]
+        self.rx_km_vals = R_sc_km_vals[:, 0]
+        self.ry_km_vals = R_sc_km_vals[:, 1]
+        self.rz_km_vals = R_sc_km_vals[:, 2]
+        self.vx_kms_vals = R_sc_dot_kms_vals[:, 0]
+        self.vy_kms_vals = R_sc_dot_kms_vals[:, 1]
+        self.vz_kms_vals = R_sc_dot_kms_vals[:, 2]
 
         self.kernels = kernels
         self.elev_deg_vals = np.asarray(elev_deg_vals)
@@ -308,7 +329,11 @@ class Geometry(object):
         input_kwds = {
                 "pt_per_sec": pt_per_sec
                 }
-        self.history = write_history_dict(input_vars, input_kwds, __file__)
+        add_info = kernel_session.info()
+        add_info["kernel_load_time_sec"] = round(
+                kernel_session.load_time - load_time_start, 3)
+        self.history = write_history_dict(input_vars, input_kwds, __file__,
+                add_info=add_info)
 
 
         self.freespace_km, self.freespace_spm = cog.get_freespace(
@@ -316,10 +341,6 @@ class Geometry(object):
                 phi_rl_deg_vals, t_oet_spm_vals, self.atmos_occ_spm_vals,
                 split_ind=self.split_ind, kernels=kernels)
 
-        # Write output data and label file if set
-        if write_file:
-            write_output_files(self)
-
     def __get_naif_version(self):
         """
         Return NAIF toolkit version used.
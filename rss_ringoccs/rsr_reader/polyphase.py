@@ -0,0 +1,170 @@
+"""
+Purpose:
+    Single-pass polyphase FIR decimator used by RSRReader to bring 16 kHz
+    data down to 1 kHz. The filter is designed once per set of parameters
+    and cached, and data may be passed in one block at a time, with the
+    filter state carried between blocks, so the full-rate signal never has
+    to be held in memory.
+
+Dependencies:
+    #. numpy
+    #. scipy.signal.firwin
+"""
+
+import numpy as np
+from scipy.signal import firwin
+
+# Filters that have already been designed, keyed on (q, n_half, beta)
+__filter_cache = {}
+
+
+def design_filter(q, n_half=16, beta=8.0):
+    """
+    Purpose:
+        Design (or fetch from the cache) a linear phase lowpass FIR filter
+        for decimating by a factor q. The filter has 2*q*n_half+1 taps, so
+        its group delay of q*n_half input samples is a whole number of
+        output samples, and the -6 dB point is at the output Nyquist
+        frequency.
+
+    Arguments:
+        :q (*int*):
+            Decimation factor
+
+    Keyword Arguments:
+        :n_half (*int*):
+            Half the number of taps per polyphase branch. Default is 16
+        :beta (*float*):
+            Kaiser window shape parameter. Default is 8.0, which gives
+            about 80 dB of stopband attenuation
+
+    Returns:
+        :taps (*np.ndarray*):
+            Filter coefficients, normalized to unit gain at DC. The array
+            is shared by all callers and must not be modified.
+    """
+
+    key = (int(q), int(n_half), float(beta))
+    if key not in __filter_cache:
+        taps = firwin(2 * q * n_half + 1, 1.0 / q, window=('kaiser', beta))
+        taps /= np.sum(taps)
+        taps.flags.writeable = False
+        __filter_cache[key] = taps
+
+    return __filter_cache[key]
+
+
+class PolyphaseDecimator(object):
+    """
+    Purpose:
+        Decimate a complex signal with a polyphase FIR filter, one block at
+        a time. Output sample n is centered on input sample n*q, which is the
+        same time alignment as ``scipy.signal.decimate(..., zero_phase=True)``,
+        and the total number of output samples is ceil(N/q) for N input
+        samples. The start and end of the signal are padded with zeros.
+
+    Arguments:
+        :q (*int*):
+            Decimation factor
+
+    Keyword Arguments:
+        :n_half (*int*):
+            Half the number of taps per polyphase branch. Default is 16
+        :beta (*float*):
+            Kaiser window shape parameter. Default is 8.0
+        :dtype (*type*):
+            Complex type used for filtering. Default is np.complex64, which
+            is exact for the 8 and 16 bit samples in RSR files, and keeps
+            the relative error of the filter output near 1e-7
+
+    Example:
+        >>> dec = PolyphaseDecimator(16)
+        >>> out = [dec.process(IQ_chunk) for IQ_chunk in chunks]
+        >>> out.append(dec.flush())
+        >>> IQ_1khz = np.hstack(out)
+    """
+
+    def __init__(self, q, n_half=16, beta=8.0, dtype=np.complex64):
+        self.q = int(q)
+        self.dtype = np.dtype(dtype)
+        self.taps = design_filter(self.q, n_half=n_half, beta=beta)
+        self.__delay = self.q * int(n_half)
+
+        # Split the reversed taps into q polyphase branches
+        real_type = np.zeros(1, dtype=self.dtype).real.dtype
+        taps_rev = self.taps[::-1].astype(real_type)
+        self.__branches = [taps_rev[r::self.q] for r in range(self.q)]
+
+        self.reset()
+
+    def reset(self):
+        """
+        Purpose:
+            Clear the filter state to start a new signal
+        """
+        self.__buffer = np.zeros(self.__delay, dtype=self.dtype)
+
+    def process(self, IQ):
+        """
+        Purpose:
+            Filter and decimate the next block of the signal
+
+        Arguments:
+            :IQ (*np.ndarray*):
+                Next block of input samples, of any length
+
+        Returns:
+            :IQ_dec (*np.ndarray*):
+                Every output sample that can be computed from the input
+                so far. This may be empty for short blocks
+        """
+
+        q = self.q
+        n_taps = np.size(self.taps)
+        buf = np.concatenate((self.__buffer, np.asarray(IQ, dtype=self.dtype)))
+
+        if np.size(buf) < n_taps:
+            self.__buffer = buf
+            return np.zeros(0, dtype=self.dtype)
+
+        # Output i uses buf[i*q:i*q+n_taps]. Split buf into q phases and
+        #     correlate each phase with its branch of the filter
+        n_out = (np.size(buf) - n_taps) // q + 1
+        IQ_dec = np.zeros(n_out, dtype=self.dtype)
+        for r in range(q):
+            h_r = self.__branches[r]
+            x_r = buf[r::q][:n_out + np.size(h_r) - 1]
+            IQ_dec += np.correlate(x_r, h_r, mode='valid')
+
+        self.__buffer = buf[n_out * q:]
+        return IQ_dec
+
+    def flush(self):
+        """
+        Purpose:
+            Pad the end of the signal with zeros and return the remaining
+            output samples, then reset the filter state
+
+        Returns:
+            :IQ_dec (*np.ndarray*):
+                Final output samples of the signal
+        """
+        IQ_dec = self.process(np.zeros(self.__delay, dtype=self.dtype))
+        self.reset()
+        return IQ_dec
+
+    def decimate(self, IQ):
+        """
+        Purpose:
+            Decimate a whole signal in one call
+
+        Arguments:
+            :IQ (*np.ndarray*):
+                Input signal
+
+        Returns:
+            :IQ_dec (*np.ndarray*):
+                Decimated signal, of length ceil(len(IQ)/q)
+        """
+        self.reset()
+        return np.hstack((self.process(IQ), self.flush()))
@@ -17,6 +17,8 @@ import time
 
 from ..tools.history import get_rev_info
 from ..tools.history import write_history_dict
+from ..tools import instrument
+from .polyphase import PolyphaseDecimator
 
 
 class RSRReader(object):
@@ -39,9 +41,28 @@ class RSRReader(object):
             will be True for any subsequent calls from the instance until
             you explicitly set it to False. This keyword is linked to the
             private attribute __decimate_16khz_to_1khz
+        :decimate_mode (*str*):
+            Filter used to decimate 16kHz files to 1kHz. 'scipy' applies
+            ``scipy.signal.decimate(..., zero_phase=True)`` twice, decimating
+            by 4 each time, to the fully read signal. 'polyphase' applies a
+            single 513-tap FIR filter (see ``polyphase.py``) in one pass,
+            in complex64, as the SFDUs are decoded, so the 16kHz signal is
+            never held in memory. Both keep the time of each 1kHz sample.
+            Default is 'scipy'
         :cpu_count (*int*):
             Number of cores to use when reading data in from
             file. Default is number of cores on your computer
+        :use_memmap (*bool*):
+            Optional Boolean argument which, if set to True, memory maps
+            the RSR file and reads all SFDUs at once through a structured
+            numpy dtype, instead of unpacking one SFDU at a time in worker
+            processes. Both give identical results. Default is True
+        :spm_range (*list*):
+            Optional 2-element list of the range of SPM values to read I and
+            Q over. Only the SFDUs covering this range are decoded, found by
+            seeking with the number of points per SFDU. Pad the range by a
+            few seconds if decimating, since the decimation filter has edge
+            effects. Default is the entire file
         :verbose (*bool*):
             Optional boolean variable which, when set to True,
             prints the header attributes that were set
@@ -72,6 +93,7 @@ class RSRReader(object):
         #. os
         #. platform
         #. scipy.signal.decimate
+        #. rss_ringoccs.rsr_reader.polyphase
         #. struct
         #. sys
         #. time
@@ -165,7 +187,12 @@ class RSRReader(object):
     __field_names = (__sfdu_field_names + __ha_field_names + __ph_field_names
         + __sh_field_names + __data_field_names)
 
-    def __init__(self, rsr_file, decimate_16khz_to_1khz=True, verbose=False):
+    # numpy equivalents of the struct format characters used above
+    __np_formats = {'c': 'S1', 'b': 'i1', 'B': 'u1', 'h': 'i2', 'H': 'u2',
+        'I': 'u4', 'Q': 'u8', 'd': 'f8'}
+
+    def __init__(self, rsr_file, decimate_16khz_to_1khz=True, verbose=False,
+            use_memmap=True, spm_range=None, decimate_mode='scipy'):
         """
         Purpose:
             Sets full path name of RSR file as an attribute to the instance, and
@@ -188,10 +215,32 @@ class RSRReader(object):
                 + 'Python booleans instead')
             decimate_16khz_to_1khz = False
 
+        if not isinstance(use_memmap, bool):
+            print('WARNING (RSRReader): use_memmap input should be Boolean. '
+                + 'Assuming True. If you\'re trying to use 1 or 0, then you '
+                +'should use the built-in Python booleans instead')
+            use_memmap = True
+
+        if decimate_mode not in ['scipy', 'polyphase']:
+            print('WARNING (RSRReader): decimate_mode must be \'scipy\' or '
+                + '\'polyphase\'. Assuming \'scipy\'')
+            decimate_mode = 'scipy'
+
+        if spm_range is not None:
+            try:
+                spm_range = [float(min(spm_range)), float(max(spm_range))]
+            except (TypeError, ValueError) as err:
+                print('ERROR (RSRReader): spm_range must be a 2-element list '
+                    + 'of floats or integers: {}'.format(err))
+                sys.exit()
+
         self.rsr_file = rsr_file
+        self.__use_memmap = use_memmap
+        self.__spm_range = spm_range
 
         # Default argment for __set_IQ and cpu_count
         self.__decimate_16khz_to_1khz = decimate_16khz_to_1khz
+        self.__decimate_mode = decimate_mode
         self.__cpu_count = multiprocessing.cpu_count()
 
         # Record information about the run
@@ -226,6 +275,18 @@ class RSRReader(object):
         # Find number of SFDU in file, and number of points per SFDU
         rsr_size = os.path.getsize(self.rsr_file)
         bytes_per_sfdu = sfdu_hdr_dict['sfdu_length'] + 20
+
+        # A byte swapped SFDU length can't fit in the file, so the file
+        #     must have been written in the other byte order
+        if bytes_per_sfdu > rsr_size:
+            self.__endian = '<' if self.__endian == '>' else '>'
+            struct_hdr_fmt = self.__endian + struct_hdr_fmt[1:]
+            sfdu_hdr = struct.Struct(struct_hdr_fmt).unpack_from(sfdu_hdr_raw)
+            sfdu_hdr_dict = dict(zip(self.__field_names, sfdu_hdr))
+            bytes_per_sfdu = sfdu_hdr_dict['sfdu_length'] + 20
+            if verbose:
+                print('\tFile is in ' + ('little' if self.__endian == '<'
+                    else 'big') + '-endian byte order')
         n_sfdu = int(rsr_size / bytes_per_sfdu)
         if rsr_size % bytes_per_sfdu != 0 and verbose is True:
             print('WARNING (RSRReader): file size not the same as expected!\n'
@@ -262,9 +323,13 @@ class RSRReader(object):
         if self.doy == 0:
             self.doy = sfdu_hdr_dict['sh_sfdu_doy']
 
-        # Set attributes for later reading of rest of RSR file
+        # Set attributes for later reading of rest of RSR file. SPM of the
+        #     full file is kept, since SFDUs are indexed from its start
         self.__n_pts_per_sfdu = n_pts_per_sfdu
         self.__n_sfdu = n_sfdu
+        self.__spm_raw = spm_vals
+        self.__dt_raw = dt
+        self.__set_sfdu_dtype(sh_bits_per_sample, bytes_per_sfdu)
 
         if verbose:
             print('\t\tSPM range:\t\t' + str(self.spm_vals[0]) + ', '
@@ -291,6 +356,77 @@ class RSRReader(object):
         self.__set_rev_info()
 
 
+    def __set_sfdu_dtype(self, bits_per_sample, bytes_per_sfdu):
+        """
+        Purpose:
+            Set private attribute ``__sfdu_dtype``, a structured numpy dtype
+            with the same layout as one SFDU, so that the RSR file can be
+            memory mapped as an array of SFDUs. Header fields have the names
+            in ``__field_names``, and the samples are in the field
+            ``Data_QI``, an array of (Q, I) pairs
+
+        Arguments:
+            :bits_per_sample (*int*):
+                Bits per I or Q sample, from the secondary header
+            :bytes_per_sfdu (*int*):
+                Total length of an SFDU in bytes
+        """
+
+        hdr_format = (self.__sfdu_format + self.__ha_format + self.__ph_format
+            + self.__sh_format + self.__data_header_format)
+
+        fields = []
+        for name, fmt in zip(self.__field_names[:-1], hdr_format):
+            if fmt == 'c':
+                fields.append((name, self.__np_formats[fmt]))
+            else:
+                fields.append((name, self.__endian + self.__np_formats[fmt]))
+
+        if bits_per_sample == 8:
+            sample_format = 'i1'
+        else:
+            sample_format = self.__endian + 'i2'
+        fields.append(('Data_QI', sample_format, (self.__n_pts_per_sfdu, 2)))
+
+        # Pad out to the SFDU length given in the header
+        n_pad = bytes_per_sfdu - np.dtype(fields).itemsize
+        if n_pad > 0:
+            fields.append(('sfdu_pad', 'V' + str(n_pad)))
+
+        self.__sfdu_dtype = np.dtype(fields)
+
+        # Bytes per SFDU, also used by the memory mapped read, for which
+        #     __set_sfdu_unpack does not set it
+        self.__sfdu_len = self.__sfdu_dtype.itemsize
+
+    def __get_sfdu_range(self, spm_range):
+        """
+        Purpose:
+            Find the first and last SFDU covering a range of SPM values.
+            Raw SPM is evenly spaced from the start of the file, so the
+            nearest sample is found directly rather than by searching
+
+        Arguments:
+            :spm_range (*list*):
+                2-element array of range of SPM values
+
+        Returns:
+            :start_sfdu (*int*): First SFDU covering ``spm_range``
+            :end_sfdu (*int*): Last SFDU covering ``spm_range``
+        """
+
+        n_pts = len(self.__spm_raw)
+        spm_inds = np.round((np.array(spm_range, dtype=float)
+            - self.__spm_raw[0]) / self.__dt_raw)
+        spm_inds = np.clip(spm_inds, 0, n_pts - 1).astype(int)
+
+        start_sfdu = int(spm_inds[0] / self.__n_pts_per_sfdu)
+        end_sfdu = int(spm_inds[1] / self.__n_pts_per_sfdu)
+        if end_sfdu > self.__n_sfdu:
+            end_sfdu = self.__n_sfdu
+
+        return start_sfdu, end_sfdu
+
     def __set_sfdu_unpack(self, spm_range):
         """
         Purpose:
@@ -306,16 +442,17 @@ class RSRReader(object):
         """
 
         # Specify which SFDUs you want to read
-        if self.sample_rate_khz == 1:
-            start_spm_ind = np.argmin(abs(self.spm_vals - spm_range[0]))
-            end_spm_ind = np.argmin(abs(self.spm_vals - spm_range[1]))
-        elif self.sample_rate_khz == 16:
-            start_spm_ind = np.argmin(abs(self.__spm_16khz - spm_range[0]))
-            end_spm_ind = np.argmin(abs(self.__spm_16khz - spm_range[1]))
-        start_sfdu = int(start_spm_ind / self.__n_pts_per_sfdu)
-        end_sfdu = int(end_spm_ind / self.__n_pts_per_sfdu)
-        if end_sfdu > self.__n_sfdu:
-            end_sfdu = self.__n_sfdu
+        start_sfdu, end_sfdu = self.__get_sfdu_range(spm_range)
+
+        self.__start_sfdu = start_sfdu
+        self.__end_sfdu = end_sfdu
+
+        # Memory map the file as an array of SFDUs; nothing is read until
+        #     a field is accessed
+        if self.__use_memmap:
+            self.__rsr_map = np.memmap(self.rsr_file, mode='r',
+                dtype=self.__sfdu_dtype, shape=(self.__n_sfdu,))
+            return
 
         # Format in which to read rest of RSR file one SFDU at a time
         data_format = (self.__data_header_format
@@ -335,8 +472,6 @@ class RSRReader(object):
         # Define private attributes of object
         self.__sfdu_unpack = sfdu_unpack
         self.__rsr_struct = rsr_struct
-        self.__start_sfdu = start_sfdu
-        self.__end_sfdu = end_sfdu
         self.__sfdu_len = sfdu_len
 
     def get_f_sky_pred(self, f_spm=None, verbose=False):
@@ -381,10 +516,8 @@ class RSRReader(object):
                 +'should use the built-in Python booleans instead')
             verbose = False
 
-        if self.sample_rate_khz == 1:
-            spm_vals = self.spm_vals
-        elif self.sample_rate_khz == 16:
-            spm_vals = self.__spm_16khz
+        if (self.sample_rate_khz == 1) or (self.sample_rate_khz == 16):
+            spm_vals = self.__spm_raw
         else:
             print('ERROR (RSRReader.f_sky_pred()): Sample rate must be either'
                 + '16kHz or 1kHz')
@@ -422,6 +555,72 @@ class RSRReader(object):
         if verbose:
             print('\tAssembling arrays of frequency polynomials from RSR file...')
 
+        if self.__use_memmap:
+            # Frequency polynomials straight from the mapped SFDU headers
+            sfdus = self.__rsr_map[self.__start_sfdu:self.__end_sfdu + 1]
+            rfif_lo_array = sfdus['sh_rfif_lo'].astype(float)
+            ddc_lo_array = sfdus['sh_ddc_lo'].astype(float)
+            freq_poly1_array = sfdus['sh_schan_freq_poly_coef_1'].astype(float)
+            freq_poly2_array = sfdus['sh_schan_freq_poly_coef_2'].astype(float)
+            freq_poly3_array = sfdus['sh_schan_freq_poly_coef_3'].astype(float)
+            time_stamp_array = np.round(spm_vals[self.__n_pts_per_sfdu
+                * np.arange(self.__start_sfdu, self.__start_sfdu
+                + len(sfdus))], round_decimal)
+
+            # Release the map so it isn't kept (or pickled) with the instance
+            del sfdus
+            del self.__rsr_map
+        else:
+            (rfif_lo_array, ddc_lo_array, freq_poly1_array, freq_poly2_array,
+                freq_poly3_array, time_stamp_array) = (
+                self.__loop_f_sky_pred(spm_vals, round_decimal))
+
+        if verbose:
+            print('\tEvaluating sky frequency at desired SPM...')
+
+        # Calculate sky frequency for the input time array
+        f_sky_pred = np.zeros(len(f_spm))
+        for i in range(len(f_spm)):
+            # Find correct frequency info for time
+            _ind = np.arange(len(time_stamp_array))
+            _time_ind = (_ind[f_spm[i] >= time_stamp_array])[-1]
+
+            _msec = f_spm[i] - f_spm[i].astype(int)
+            f_sky_pred[i] = ((rfif_lo_array[_time_ind]
+                + ddc_lo_array[_time_ind]) * 1.0e6
+                - freq_poly1_array[_time_ind]
+                - freq_poly2_array[_time_ind] * _msec
+                - freq_poly3_array[_time_ind] * (_msec ** 2))
+
+            if verbose and (i < 10):
+                print(_msec, f_spm[i], _time_ind, time_stamp_array[_time_ind],
+                    freq_poly1_array[_time_ind], freq_poly2_array[_time_ind],
+                    freq_poly3_array[_time_ind])
+
+        if verbose:
+            for i in range(10):
+                print('%24.16f    %30.16f' % (f_spm[i], f_sky_pred[i]))
+
+        # Return f_spm and evaluated predicted sky frequency
+        return f_spm, f_sky_pred
+
+    def __loop_f_sky_pred(self, spm_vals, round_decimal):
+        """
+        Purpose:
+            Unpack the frequency polynomials of each SFDU in the range set
+            by ``__set_sfdu_unpack``, one SFDU at a time
+
+        Arguments:
+            :spm_vals (*np.ndarray*):
+                Raw resolution SPM values over the entire file
+            :round_decimal (*int*):
+                Number of decimals to round SFDU time stamps to
+
+        Returns:
+            Arrays of RFIF LO, DDC LO, the three frequency polynomial
+            coefficients, and the time stamp of each SFDU
+        """
+
         # Arrays to contain sets of frequency polynomials
         rfif_lo_array = np.zeros(self.__end_sfdu - self.__start_sfdu + 1)
         ddc_lo_array = np.zeros(self.__end_sfdu - self.__start_sfdu + 1)
@@ -454,35 +653,10 @@ class RSRReader(object):
 
             n_iter += 1
 
-        if verbose:
-            print('\tEvaluating sky frequency at desired SPM...')
-
-        # Calculate sky frequency for the input time array
-        f_sky_pred = np.zeros(len(f_spm))
-        for i in range(len(f_spm)):
-            # Find correct frequency info for time
-            _ind = np.arange(len(time_stamp_array))
-            _time_ind = (_ind[f_spm[i] >= time_stamp_array])[-1]
-
-            _msec = f_spm[i] - f_spm[i].astype(int)
-            f_sky_pred[i] = ((rfif_lo_array[_time_ind]
-                + ddc_lo_array[_time_ind]) * 1.0e6
-                - freq_poly1_array[_time_ind]
-                - freq_poly2_array[_time_ind] * _msec
-                - freq_poly3_array[_time_ind] * (_msec ** 2))
-
-            if verbose and (i < 10):
-                print(_msec, f_spm[i], _time_ind, time_stamp_array[_time_ind],
-                    freq_poly1_array[_time_ind], freq_poly2_array[_time_ind],
-                    freq_poly3_array[_time_ind])
-
-        if verbose:
-            for i in range(10):
-                print('%24.16f    %30.16f' % (f_spm[i], f_sky_pred[i]))
-
-        # Return f_spm and evaluated predicted sky frequency
-        return f_spm, f_sky_pred
+        return (rfif_lo_array, ddc_lo_array, freq_poly1_array,
+            freq_poly2_array, freq_poly3_array, time_stamp_array)
 
+    @instrument.timed('rsr_reader.set_IQ')
     def __set_IQ(self, verbose=False):
         """
         Purpose:
@@ -509,12 +683,6 @@ class RSRReader(object):
 #                 + 'Assuming False')
 #             verbose = False
 
-        spm_vals = self.spm_vals
-
-        # Record what original SPM values were
-        if self.sample_rate_khz == 16:
-            self.__spm_16khz = spm_vals
-
         # Ensure that input is a Boolean
 #         if type(self.__decimate_16khz_to_1khz) != bool:
 #             print('WARNING (RSRReader.get_IQ): Expected Boolean input for ' +
@@ -523,40 +691,45 @@ class RSRReader(object):
 
         decimate_16khz_to_1khz = self.__decimate_16khz_to_1khz
 
-        spm_range = [min(spm_vals), max(spm_vals)]
+        if self.__spm_range is None:
+            spm_range = [min(self.__spm_raw), max(self.__spm_raw)]
+        else:
+            spm_range = self.__spm_range
         self.__set_sfdu_unpack(spm_range)
 
         # Reduce SPM array to match the I and Q arrays to be made
-        spm_vals = self.spm_vals[self.__n_pts_per_sfdu * self.__start_sfdu:
+        spm_vals = self.__spm_raw[self.__n_pts_per_sfdu * self.__start_sfdu:
             self.__n_pts_per_sfdu * (self.__end_sfdu + 1)]
 
-        # Multiprocessing to retrieve data from RSR file
-        results = []
-        queues = [Queue() for i in range(self.__cpu_count)]
-        n_loops = self.__end_sfdu - self.__start_sfdu + 1
-        n_per_core = int(np.floor(n_loops / self.__cpu_count))
-        loop_args = [(i * n_per_core, (i + 1) * n_per_core, n_loops,
-            queues[i]) for i in range(self.__cpu_count)]
-        loop_args[-1] = ((self.__cpu_count - 1) * n_per_core,
-            self.__end_sfdu + 1, n_loops, queues[-1])
-        jobs = [Process(target=self.__loop, args=(a)) for a in loop_args]
-        for j in jobs:
-            j.start()
-        for q in queues:
-            results.append(q.get())
-        for j in jobs:
-            j.join()
-        IQ_m = np.hstack(results)
-        #print('\n')
+        polyphase = (decimate_16khz_to_1khz & (self.sample_rate_khz == 16)
+            and (self.__decimate_mode == 'polyphase'))
+
+        if polyphase and self.__use_memmap:
+            if verbose:
+                print('\tDecimating to 1kHz sampling while reading...')
+            IQ_m = self.__read_IQ_decimated()
+        elif self.__use_memmap:
+            IQ_m = self.__read_IQ_memmap()
+        else:
+            IQ_m = self.__read_IQ_multiprocessing()
+
+        n_sfdu = self.__end_sfdu - self.__start_sfdu + 1
+        instrument.count('rsr_reader.bytes_read', n_sfdu * self.__sfdu_len)
+        instrument.count('rsr_reader.points_read',
+                n_sfdu * self.__n_pts_per_sfdu)
 
         # Decimate 16kHz file to 1kHz spacing if specified
         if decimate_16khz_to_1khz & (self.sample_rate_khz == 16):
 
-            if verbose:
-                print('\tDecimating to 1kHz sampling...')
-
-            IQ_m = decimate(IQ_m, 4, zero_phase=True)
-            IQ_m = decimate(IQ_m, 4, zero_phase=True)
+            if polyphase and not self.__use_memmap:
+                if verbose:
+                    print('\tDecimating to 1kHz sampling...')
+                IQ_m = PolyphaseDecimator(16).decimate(IQ_m).astype(complex)
+            elif not polyphase:
+                if verbose:
+                    print('\tDecimating to 1kHz sampling...')
+                IQ_m = decimate(IQ_m, 4, zero_phase=True)
+                IQ_m = decimate(IQ_m, 4, zero_phase=True)
 
             n_pts = len(IQ_m)
             dt = 1.0 / float(1000)
@@ -577,6 +750,167 @@ class RSRReader(object):
         self.spm_vals = spm_vals
         self.IQ_m = IQ_m
 
+    def __read_IQ_memmap(self):
+        """
+        Purpose:
+            Read I and Q over the SFDUs set by ``__set_sfdu_unpack`` from
+            the memory mapped file. The samples are strided views into the
+            map, cast straight into the real and imaginary parts of the
+            output, so there is no per-SFDU Python work
+
+        Returns:
+            :IQ_m (*np.ndarray*):
+                Raw measured complex signal
+        """
+
+        IQ_m = self.__data_to_IQ(self.__rsr_map['Data_QI'][self.__start_sfdu:
+            self.__end_sfdu + 1])
+
+        # Release the map so it isn't kept (or pickled) with the instance
+        del self.__rsr_map
+
+        return IQ_m
+
+    def __read_IQ_decimated(self, chunk_sfdus=1000):
+        """
+        Purpose:
+            Read I and Q over the SFDUs set by ``__set_sfdu_unpack`` from
+            the memory mapped file, decimating each chunk to 1kHz as it is
+            decoded
+
+        Arguments:
+            :chunk_sfdus (*int*):
+                Number of SFDUs decoded at a time. Default is 1000
+
+        Returns:
+            :IQ_m (*np.ndarray*):
+                Raw measured complex signal, decimated to 1kHz
+        """
+
+        dec = PolyphaseDecimator(16)
+        data = self.__rsr_map['Data_QI']
+        IQ_dec = []
+        for i_sfdu in range(self.__start_sfdu, self.__end_sfdu + 1,
+                chunk_sfdus):
+            j_sfdu = min(i_sfdu + chunk_sfdus, self.__end_sfdu + 1)
+            IQ_dec.append(dec.process(self.__data_to_IQ(data[i_sfdu:j_sfdu],
+                dtype=dec.dtype)))
+        IQ_dec.append(dec.flush())
+
+        # Release the map so it isn't kept (or pickled) with the instance
+        del data
+        del self.__rsr_map
+
+        return np.hstack(IQ_dec).astype(complex)
+
+    def __data_to_IQ(self, data, dtype=complex):
+        """
+        Purpose:
+            Cast the ``Data_QI`` field of a range of mapped SFDUs into a
+            complex array
+
+        Arguments:
+            :data (*np.ndarray*):
+                Samples of each SFDU, stored as (Q, I) pairs
+            :dtype (*type*):
+                Complex type of the output. Default is complex
+
+        Returns:
+            :IQ_m (*np.ndarray*):
+                Raw measured complex signal
+        """
+
+        IQ_m = np.empty(data.shape[:2], dtype=dtype)
+        IQ_m.real = data[:, :, 1]
+        IQ_m.imag = data[:, :, 0]
+
+        return IQ_m.reshape(-1)
+
+    def __read_IQ_multiprocessing(self):
+        """
+        Purpose:
+            Read I and Q over the SFDUs set by ``__set_sfdu_unpack`` by
+            unpacking one SFDU at a time, split over ``__cpu_count``
+            processes
+
+        Returns:
+            :IQ_m (*np.ndarray*):
+                Raw measured complex signal
+        """
+
+        # Multiprocessing to retrieve data from RSR file
+        results = []
+        queues = [Queue() for i in range(self.__cpu_count)]
+        n_loops = self.__end_sfdu - self.__start_sfdu + 1
+        n_per_core = int(np.floor(n_loops / self.__cpu_count))
+        i0 = self.__start_sfdu
+        loop_args = [(i0 + i * n_per_core, i0 + (i + 1) * n_per_core, n_loops,
+            queues[i]) for i in range(self.__cpu_count)]
+        loop_args[-1] = (i0 + (self.__cpu_count - 1) * n_per_core,
+            self.__end_sfdu + 1, n_loops, queues[-1])
+        jobs = [Process(target=self.__loop, args=(a)) for a in loop_args]
+        for j in jobs:
+            j.start()
+        for q in queues:
+            results.append(q.get())
+        for j in jobs:
+            j.join()
+        IQ_m = np.hstack(results)
+        #print('\n')
+
+        return IQ_m
+
+    def iter_IQ(self, chunk_sfdus=1000, spm_range=None):
+        """
+        Purpose:
+            Iterate over the raw measured I and Q a fixed number of SFDUs at
+            a time, so that long or 16kHz files can be processed in bounded
+            memory. Samples are read from a memory map of the file at the raw
+            sample rate; no decimation is applied
+
+        Arguments:
+            :chunk_sfdus (*int*):
+                Number of SFDUs in each chunk. Default is 1000
+            :spm_range (*list*):
+                2-element array of range of SPM values to iterate over.
+                Default is the ``spm_range`` the instance was created with,
+                or the entire file
+
+        Yields:
+            :spm_vals (*np.ndarray*):
+                Raw resolution SPM values of the chunk
+            :IQ_m (*np.ndarray*):
+                Raw measured complex signal of the chunk
+
+        Example:
+            >>> for spm_chunk, IQ_chunk in rsr_inst.iter_IQ(chunk_sfdus=500):
+            >>>     process(spm_chunk, IQ_chunk)
+        """
+
+        if (not isinstance(chunk_sfdus, int)) or (chunk_sfdus < 1):
+            print('ERROR (RSRReader.iter_IQ): chunk_sfdus must be a positive '
+                + 'integer')
+            sys.exit()
+
+        if spm_range is None:
+            spm_range = self.__spm_range
+        if spm_range is None:
+            spm_range = [min(self.__spm_raw), max(self.__spm_raw)]
+
+        start_sfdu, end_sfdu = self.__get_sfdu_range(spm_range)
+        n_pts = self.__n_pts_per_sfdu
+
+        rsr_map = np.memmap(self.rsr_file, mode='r', dtype=self.__sfdu_dtype,
+            shape=(self.__n_sfdu,))
+
+        for i_sfdu in range(start_sfdu, end_sfdu + 1, chunk_sfdus):
+            j_sfdu = min(i_sfdu + chunk_sfdus, end_sfdu + 1)
+
+            yield (self.__spm_raw[i_sfdu * n_pts:j_sfdu * n_pts],
+                self.__data_to_IQ(rsr_map['Data_QI'][i_sfdu:j_sfdu]))
+
+        del rsr_map
+
     def __loop(self, i_start, i_end, n_loops, queue=0):
         """
         Purpose:
@@ -628,7 +962,10 @@ class RSRReader(object):
         """
         input_var_dict = {'rsr_file': self.rsr_file}
         input_kw_dict = {
-            'decimate_16khz_to_1khz': self.__decimate_16khz_to_1khz}
+            'decimate_16khz_to_1khz': self.__decimate_16khz_to_1khz,
+            'use_memmap': self.__use_memmap,
+            'spm_range': self.__spm_range,
+            'decimate_mode': self.__decimate_mode}
 
         self.history = write_history_dict(input_var_dict, input_kw_dict,
                 __file__)
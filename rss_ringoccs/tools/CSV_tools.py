@@ -4,23 +4,133 @@
         .CSV files and converting the data into
         a usable instance of the DLP class.
     Dependencies:
+        #. os
         #. pandas
         #. numpy
         #. scipy
         #. rss_ringoccs
 """
 
+import os
 import numpy as np
 import pandas as pd
 from scipy import interpolate
 from .history import write_history_dict, date_to_rev, rev_to_occ_info
+from .columnar import read_columns
 RADS_PER_DEGS = 0.0174532925199432957692369
 
-def get_geo(geo, verbose=True):
+# Points of the tau file kept on either side of rng. A cubic spline
+#   point is changed by about 0.27**n by a point n samples away, so
+#   32 is well below double precision.
+TAU_SPLINE_PAD = 32
+
+def is_binary(path):
+    """
+        Purpose:
+            Determine if a file is a binary columnar .NPZ
+            file written next to a .TAB file (see
+            write_output_files.set_binary_output).
+        Arguments:
+            :path (*str*):
+                Location of the file.
+    """
+    return path.lower().endswith('.npz')
+
+# Parsed columns of text files, by (path, size, modification time).
+_csv_cache = {}
+
+# Number of files whose columns are kept.
+CSV_CACHE_FILES = 8
+
+def read_csv_columns(path, names, usecols=None):
+    """
+        Purpose:
+            Parse columns of a comma separated .TAB or
+            .CSV file with the C parser of pandas. The
+            parsed columns are kept until the file changes,
+            so reading the file again, e.g. for every step
+            of a resolution scan, only parses the columns
+            that were not needed before.
+        Arguments:
+            :path (*str*):
+                Location of the file.
+            :names (*list*):
+                Names of all of the columns, in order.
+        Keywords:
+            :usecols (*list*):
+                Names of the columns to parse. All are
+                parsed if None.
+        Outputs:
+            :df (*object*):
+                pandas DataFrame with the columns in
+                usecols, as float64.
+    """
+    if usecols is None:
+        usecols = names
+    else:
+        usecols = [name for name in names if name in usecols]
+
+    stat = os.stat(path)
+    ident = (os.path.abspath(path), stat.st_size, stat.st_mtime)
+    if ident not in _csv_cache:
+        # Forget older versions of the file, then the oldest file.
+        for key in [key for key in _csv_cache if key[0] == ident[0]]:
+            del _csv_cache[key]
+        while len(_csv_cache) >= CSV_CACHE_FILES:
+            del _csv_cache[next(iter(_csv_cache))]
+        _csv_cache[ident] = {}
+    columns = _csv_cache[ident]
+
+    missing = [name for name in usecols if name not in columns]
+    if missing:
+        df = pd.read_csv(path, delimiter=',', header=None, names=names,
+                         usecols=missing, dtype=np.float64, engine='c')
+        for name in missing:
+            columns[name] = df[name].values
+
+    # Copies, so that the kept columns cannot be changed by the caller.
+    return pd.DataFrame({name: columns[name] for name in usecols},
+                        columns=usecols)
+
+def clear_csv_cache():
+    """
+        Purpose:
+            Forget the columns kept by read_csv_columns.
+    """
+    _csv_cache.clear()
+
+def read_binary(path):
+    """
+        Purpose:
+            Read the columns of a binary .NPZ file. Columns
+            of uncompressed files are memory-mapped, so no
+            text is parsed and only the parts of the file
+            that are used are read from disk.
+        Arguments:
+            :path (*str*):
+                Location of the file.
+                Ex: path = "/path/to/geo.NPZ"
+        Outputs:
+            :columns (*object*):
+                Instance of columnar.ColumnSet, with the
+                same column names as the DataFrame read
+                from the corresponding .TAB file.
+    """
+    try:
+        return read_columns(path)
+    except FileNotFoundError:
+        raise FileNotFoundError(
+            "\n\tYour input file does not exists.\n"
+            "\tYour file: '%s'\n"
+            % (path)
+        )
+
+def get_geo(geo, verbose=True, usecols=None):
     """
         Purpose:
             To extract a pandas DataFrame from a given
-            GEO.TAB or GEO.CSV file.
+            GEO.TAB or GEO.CSV file, or the
+            columns of the binary GEO.NPZ file written with it.
         Arguments:
             :geo (*str*):
                 A string containing the location of
@@ -51,6 +161,12 @@ def get_geo(geo, verbose=True):
             :verbose (*bool*):
                 A Boolean for printing out auxiliary
                 information to the command line.
+            :usecols (*list*):
+                Names of the columns to parse. Other
+                columns are skipped. All are parsed if
+                None. Columns are kept for as long as
+                the file is unchanged, so they are only
+                parsed once (see read_csv_columns).
     """
     if (not isinstance(geo, str)):
         raise TypeError(
@@ -73,47 +189,51 @@ def get_geo(geo, verbose=True):
     if verbose:
         print("\tExtracting Geo Data...")
 
-    try:
-        dfg = pd.read_csv(geo, delimiter=',',
-            names=[
-                "t_oet_spm_vals",
-                "t_ret_spm_vals",
-                "t_set_spm_vals",
-                "rho_km_vals",
-                "phi_rl_deg_vals",
-                "phi_ora_deg_vals",
-                "B_deg_vals",
-                "D_km_vals",
-                "rho_dot_kms_vals",
-                "phi_rl_dot_kms_vals",
-                "F_km_vals",
-                "R_imp_km_vals",
-                "rx_km_vals",
-                "ry_km_vals",
-                "rz_km_vals",
-                "vx_kms_vals",
-                "vy_kms_vals",
-                "vz_kms_vals",
-                "obs_spacecract_lat_deg_vals"
-            ]
+    if is_binary(geo):
+        dfg = read_binary(geo)
+    else:
+        try:
+            dfg = read_csv_columns(geo, usecols=usecols,
+                names=[
+                    "t_oet_spm_vals",
+                    "t_ret_spm_vals",
+                    "t_set_spm_vals",
+                    "rho_km_vals",
+                    "phi_rl_deg_vals",
+                    "phi_ora_deg_vals",
+                    "B_deg_vals",
+                    "D_km_vals",
+                    "rho_dot_kms_vals",
+                    "phi_rl_dot_kms_vals",
+                    "F_km_vals",
+                    "R_imp_km_vals",
+                    "rx_km_vals",
+                    "ry_km_vals",
+                    "rz_km_vals",
+                    "vx_kms_vals",
+                    "vy_kms_vals",
+                    "vz_kms_vals",
+                    "obs_spacecract_lat_deg_vals"
+                ]
+                )
+        except FileNotFoundError:
+            raise FileNotFoundError(
+                "\n\tYour input geo file does not exists.\n"
+                "\tYour file: '%s'\n"
+                % (geo)
             )
-    except FileNotFoundError:
-        raise FileNotFoundError(
-            "\n\tYour input geo file does not exists.\n"
-            "\tYour file: '%s'\n"
-            % (geo)
-        )
 
     if verbose:
         print("\tGeo Data Complete.")
 
     return dfg
 
-def get_cal(cal, verbose=True):
+def get_cal(cal, verbose=True, usecols=None):
     """
         Purpose:
             To extract a pandas DataFrame from a given
-            CAL.TAB or CAL.CSV file.
+            CAL.TAB or CAL.CSV file, or the
+            columns of the binary CAL.NPZ file written with it.
         Arguments:
             :cal (*str*):
                 A string containing the location of
@@ -129,6 +249,12 @@ def get_cal(cal, verbose=True):
             :verbose (*bool*):
                 A Boolean for printing out auxiliary
                 information to the command line.
+            :usecols (*list*):
+                Names of the columns to parse. Other
+                columns are skipped. All are parsed if
+                None. Columns are kept for as long as
+                the file is unchanged, so they are only
+                parsed once (see read_csv_columns).
     """
     if (not isinstance(cal, str)):
         raise TypeError(
@@ -151,32 +277,36 @@ def get_cal(cal, verbose=True):
     if verbose:
         print("\tExtracting Cal Data...")
 
-    try:
-        dfc = pd.read_csv(cal, delimiter=',',
-            names=[
-                "spm_vals",
-                "f_sky_pred_vals",
-                "f_sky_resid_fit_vals",
-                "p_free_vals"
-                ]
+    if is_binary(cal):
+        dfc = read_binary(cal)
+    else:
+        try:
+            dfc = read_csv_columns(cal, usecols=usecols,
+                names=[
+                    "spm_vals",
+                    "f_sky_pred_vals",
+                    "f_sky_resid_fit_vals",
+                    "p_free_vals"
+                    ]
+                )
+        except FileNotFoundError:
+            raise FileNotFoundError(
+                "\n\tYour input cal file does not exists.\n"
+                "\tYour file: '%s'\n"
+                % (cal)
             )
-    except FileNotFoundError:
-        raise FileNotFoundError(
-            "\n\tYour input cal file does not exists.\n"
-            "\tYour file: '%s'\n"
-            % (cal)
-        )
 
     if verbose:
         print("\tCal Data Complete.")
 
     return dfc
 
-def get_dlp(dlp, verbose=True):
+def get_dlp(dlp, verbose=True, usecols=None):
     """
         Purpose:
             To extract a pandas DataFrame from a given
-            DLP.TAB or DLP.CSV file.
+            DLP.TAB or DLP.CSV file, or the
+            columns of the binary DLP.NPZ file written with it.
         Arguments:
             :dlp (*str*):
                 A string containing the location of
@@ -201,6 +331,12 @@ def get_dlp(dlp, verbose=True):
             :verbose (*bool*):
                 A Boolean for printing out auxiliary
                 information to the command line.
+            :usecols (*list*):
+                Names of the columns to parse. Other
+                columns are skipped. All are parsed if
+                None. Columns are kept for as long as
+                the file is unchanged, so they are only
+                parsed once (see read_csv_columns).
     """
     if (not isinstance(dlp, str)):
         raise TypeError(
@@ -223,41 +359,45 @@ def get_dlp(dlp, verbose=True):
     if verbose:
         print("\tExtracting DLP Data...")
 
-    try:
-        dfd = pd.read_csv(
-            dlp, delimiter=',',
-            names=[
-                "rho_km_vals",
-                "rho_corr_pole_km_vals",
-                "rho_corr_timing_km_vals",
-                "phi_rl_deg_vals",
-                "phi_ora_deg_vals",
-                "p_norm_vals",
-                "raw_tau_vals",
-                "phase_deg_vals",
-                "raw_tau_threshold_vals",
-                "t_oet_spm_vals",
-                "t_ret_spm_vals",
-                "t_set_spm_vals",
-                "B_deg_vals"
-            ]
-        )
-    except FileNotFoundError:
-        raise FileNotFoundError(
-            "\n\tYour input dlp file does not exists.\n"
-            "\tYour file: '%s'\n"
-            % (dlp)
-        )
+    if is_binary(dlp):
+        dfd = read_binary(dlp)
+    else:
+        try:
+            dfd = read_csv_columns(
+                dlp, usecols=usecols,
+                names=[
+                    "rho_km_vals",
+                    "rho_corr_pole_km_vals",
+                    "rho_corr_timing_km_vals",
+                    "phi_rl_deg_vals",
+                    "phi_ora_deg_vals",
+                    "p_norm_vals",
+                    "raw_tau_vals",
+                    "phase_deg_vals",
+                    "raw_tau_threshold_vals",
+                    "t_oet_spm_vals",
+                    "t_ret_spm_vals",
+                    "t_set_spm_vals",
+                    "B_deg_vals"
+                ]
+            )
+        except FileNotFoundError:
+            raise FileNotFoundError(
+                "\n\tYour input dlp file does not exists.\n"
+                "\tYour file: '%s'\n"
+                % (dlp)
+            )
 
     if verbose:
         print("\tDLP Data Complete")
     return dfd
 
-def get_tau(tau, verbose=True):
+def get_tau(tau, verbose=True, usecols=None):
     """
         Purpose:
             To extract a pandas DataFrame from a given
-            TAU.TAB or TAU.CSV file.
+            TAU.TAB or TAU.CSV file, or the
+            columns of the binary TAU.NPZ file written with it.
         Arguments:
             :tau (*str*):
                 A string containing the location of
@@ -282,6 +422,12 @@ def get_tau(tau, verbose=True):
             :verbose (*bool*):
                 A Boolean for printing out auxiliary
                 information to the command line.
+            :usecols (*list*):
+                Names of the columns to parse. Other
+                columns are skipped. All are parsed if
+                None. Columns are kept for as long as
+                the file is unchanged, so they are only
+                parsed once (see read_csv_columns).
     """
     if (not isinstance(tau, str)):
         raise TypeError(
@@ -304,30 +450,33 @@ def get_tau(tau, verbose=True):
     if verbose:
         print("\tExtracting Tau Data...")
 
-    try:
-        dft = pd.read_csv(tau, delimiter=',',
-            names=[
-                "rho_km_vals",
-                "rho_km_pole_corr_vals",
-                "rho_km_offsett_vals",
-                "phi_rl_deg_vals",
-                "phi_ora_deg_vals",
-                "p_norm_vals",
-                "raw_tau_vals",
-                "phase_deg_vals",
-                "raw_tau_threshold_vals",
-                "spm_vals",
-                "t_ret_spm_vals",
-                "t_set_spm_vals",
-                "B_deg_vals"
-            ]
-        )
-    except FileNotFoundError:
-        raise FileNotFoundError(
-            "\n\tYour input tau file does not exists.\n"
-            "\tYour file: '%s'\n"
-            % (tau)
-        )
+    if is_binary(tau):
+        dft = read_binary(tau)
+    else:
+        try:
+            dft = read_csv_columns(tau, usecols=usecols,
+                names=[
+                    "rho_km_vals",
+                    "rho_km_pole_corr_vals",
+                    "rho_km_offsett_vals",
+                    "phi_rl_deg_vals",
+                    "phi_ora_deg_vals",
+                    "p_norm_vals",
+                    "raw_tau_vals",
+                    "phase_deg_vals",
+                    "raw_tau_threshold_vals",
+                    "spm_vals",
+                    "t_ret_spm_vals",
+                    "t_set_spm_vals",
+                    "B_deg_vals"
+                ]
+            )
+        except FileNotFoundError:
+            raise FileNotFoundError(
+                "\n\tYour input tau file does not exists.\n"
+                "\tYour file: '%s'\n"
+                % (tau)
+            )
 
     if verbose:
         print("\tTau Data Complete")
@@ -365,6 +514,17 @@ class ExtractCSVData(object):
                 A Boolean for specifying if various
                 status updates will be printed to the
                 command line.
+            :rng (*list*):
+                The range of ring radii, in kilometers,
+                to keep. The DLP is cut to this range
+                before the geometry and the frequencies
+                are interpolated onto it, and only the
+                part of the tau file that covers it is
+                interpolated. A reconstruction needs
+                half a window of data on either side of
+                the range it is run on, so rng should
+                include it. If 'all', the whole DLP is
+                kept. Ex: rng = [87000.0, 89000.0]
         Attributes:
             :B_rad_vals:
                 The ring opening angle of the ring plane
@@ -430,7 +590,7 @@ class ExtractCSVData(object):
                 in the tau file. If tau is not set, this
                 will be a NoneType variable.
     """
-    def __init__(self, geo, cal, dlp, tau=None, verbose=True):
+    def __init__(self, geo, cal, dlp, tau=None, verbose=True, rng='all'):
         if (not isinstance(geo, str)):
             raise TypeError(
                 "geo must be a string: '/path/to/geo'\n"
@@ -460,6 +620,20 @@ class ExtractCSVData(object):
                 "\tSet verbose=True or verbose=False\n"
                 % (type(verbose).__name__)
             )
+        elif (not isinstance(rng, str)) and (np.size(rng) != 2):
+            raise TypeError(
+                "\n\trng must be 'all' or a list of two radii:\n"
+                "\tEx: rng = [87000.0, 89000.0]\n"
+                "\tYour input: %s\n"
+                % (rng)
+            )
+        elif isinstance(rng, str) and (rng != 'all'):
+            raise ValueError(
+                "\n\trng must be 'all' or a list of two radii:\n"
+                "\tEx: rng = [87000.0, 89000.0]\n"
+                "\tYour input: %s\n"
+                % (rng)
+            )
         else:
             pass
 
@@ -471,11 +645,19 @@ class ExtractCSVData(object):
         self.cal = cal
         self.dlp = dlp
         self.tau = tau
-
-        # Extract GEO, CAL, and DLP data.
-        geo_dat = get_geo(self.geo, verbose=verbose)
-        cal_dat = get_cal(self.cal, verbose=verbose)
-        dlp_dat = get_dlp(self.dlp, verbose=verbose)
+        self.rng = rng
+
+        # Extract GEO, CAL, and DLP data, only the columns used below.
+        geo_dat = get_geo(self.geo, verbose=verbose, usecols=[
+            "rho_km_vals", "phi_rl_deg_vals", "phi_ora_deg_vals",
+            "B_deg_vals", "D_km_vals", "rho_dot_kms_vals"])
+        cal_dat = get_cal(self.cal, verbose=verbose, usecols=[
+            "f_sky_pred_vals", "f_sky_resid_fit_vals"])
+        dlp_dat = get_dlp(self.dlp, verbose=verbose, usecols=[
+            "rho_km_vals", "rho_corr_pole_km_vals",
+            "rho_corr_timing_km_vals", "raw_tau_vals", "phase_deg_vals",
+            "raw_tau_threshold_vals", "t_oet_spm_vals", "t_ret_spm_vals",
+            "t_set_spm_vals"])
 
         if verbose:
             print("\tRetrieving Variables...")
@@ -810,13 +992,8 @@ class ExtractCSVData(object):
         if (np.size(self.rho_km_vals) != np.size(self.t_oet_spm_vals)):
             raise ValueError("len(rho_km_vals) != len(t_oet_spm_vals")
 
-        dr = np.zeros(np.size(self.rho_km_vals) - 1)
-        dt = np.zeros(np.size(self.t_oet_spm_vals) - 1)
-
-        for i in range(np.size(self.rho_km_vals) - 1):
-            dr[i] = self.rho_km_vals[i+1] - self.rho_km_vals[i]
-            dt[i] = self.t_oet_spm_vals[i+1] - self.t_oet_spm_vals[i]
-        
+        dr = np.diff(self.rho_km_vals)
+        dt = np.diff(self.t_oet_spm_vals)
         drdt = dr/dt
 
         if (np.min(drdt) < 0.0) and (np.max (drdt) > 0.0):
@@ -903,6 +1080,35 @@ class ExtractCSVData(object):
         n_f_vals = np.size(f_sky_raw_vals)
         frange = np.arange(n_f_vals)
         xrange = np.arange(n_rho_vals)*(n_f_vals-1.0)/(n_rho_vals-1.0)
+
+        # Points of the DLP that are kept, covered by the geometry and
+        #   within the requested range. Only these are interpolated.
+        keep = np.arange(rstart, rfin+1)
+        if not isinstance(rng, str):
+            keep = keep[(self.rho_km_vals[keep] >= np.min(rng)) &
+                        (self.rho_km_vals[keep] <= np.max(rng))]
+            if (np.size(keep) < 2):
+                raise ValueError(
+                    "\n\tThe DLP has fewer than two points in rng.\n"
+                    "\tYour input: %s\n"
+                    "\tDLP range: [%f, %f]\n"
+                    % (rng, np.min(self.rho_km_vals),
+                       np.max(self.rho_km_vals))
+                )
+        rstart = int(keep[0])
+        rfin = int(keep[-1])
+
+        self.t_ret_spm_vals = self.t_ret_spm_vals[rstart:rfin+1]
+        self.t_set_spm_vals = self.t_set_spm_vals[rstart:rfin+1]
+        self.t_oet_spm_vals = self.t_oet_spm_vals[rstart:rfin+1]
+        self.phase_rad_vals = phase_deg_vals[rstart:rfin+1]*RADS_PER_DEGS
+        self.rho_km_vals = self.rho_km_vals[rstart:rfin+1]
+        self.rho_corr_pole_km_vals = self.rho_corr_pole_km_vals[rstart:rfin+1]
+        self.rho_corr_timing_km_vals = self.rho_corr_timing_km_vals[rstart:rfin+1]
+        self.raw_tau_threshold_vals = self.raw_tau_threshold_vals[rstart:rfin+1]
+        raw_tau_vals = raw_tau_vals[rstart:rfin+1]
+        xrange = xrange[rstart:rfin+1]
+
         interp = interpolate.interp1d(geo_rho, geo_D, kind='cubic')
         self.D_km_vals = interp(self.rho_km_vals)
         interp = interpolate.interp1d(geo_rho, geo_drho, kind='cubic')
@@ -917,17 +1123,9 @@ class ExtractCSVData(object):
         self.f_sky_hz_vals = interp(xrange)
         raw_mu = np.sin(np.abs(self.B_rad_vals))
         self.p_norm_vals = np.exp(-raw_tau_vals/raw_mu)
-        self.t_ret_spm_vals = self.t_ret_spm_vals[rstart:rfin+1]
-        self.t_set_spm_vals = self.t_set_spm_vals[rstart:rfin+1]
-        self.t_oet_spm_vals = self.t_oet_spm_vals[rstart:rfin+1]
-        self.phase_rad_vals = phase_deg_vals[rstart:rfin+1]*RADS_PER_DEGS
-        self.rho_km_vals = self.rho_km_vals[rstart:rfin+1]
-        self.p_norm_vals = self.p_norm_vals[rstart:rfin+1]
-        self.rho_corr_pole_km_vals = self.rho_corr_pole_km_vals[rstart:rfin+1]
-        self.rho_corr_timing_km_vals = self.rho_corr_timing_km_vals[rstart:rfin+1]
 
         del f_sky_raw_vals, rmin, rmax, rstart, rfin, n_rho_vals, n_f_vals
-        del interp, frange, xrange, phi_ora_deg_vals, raw_tau_vals
+        del interp, frange, xrange, phi_ora_deg_vals, raw_tau_vals, keep
         del phase_deg_vals, raw_mu, B_deg_vals, geo_rho, geo_D
         del geo_drho, crange, geo_dat, cal_dat, dlp_dat
 
@@ -935,12 +1133,28 @@ class ExtractCSVData(object):
             if (not isinstance(tau, str)):
                 raise TypeError("taudata must be a string: '/path/to/taudata'")
             else:
-                tau_dat = get_tau(self.tau, verbose=verbose)
-                tp = tau_dat.phase_deg_vals*RADS_PER_DEGS
-                tm = tau_dat.B_deg_vals*RADS_PER_DEGS
+                tau_dat = get_tau(self.tau, verbose=verbose, usecols=[
+                    "rho_km_vals", "raw_tau_vals", "phase_deg_vals",
+                    "B_deg_vals"])
+                tr = np.array(tau_dat.rho_km_vals)
+
+                # Only the part of the tau file over the DLP, with enough
+                #   points on either side that the splines do not change.
+                n_tau = np.size(tr)
+                if (not isinstance(rng, str)) and (tr[0] <= tr[-1]):
+                    tstart = np.searchsorted(tr, np.min(self.rho_km_vals))
+                    tfin = np.searchsorted(tr, np.max(self.rho_km_vals))
+                    tslice = slice(max(int(tstart) - TAU_SPLINE_PAD, 0),
+                                   min(int(tfin) + TAU_SPLINE_PAD, n_tau))
+                    del tstart, tfin
+                else:
+                    tslice = slice(0, n_tau)
+
+                tr = tr[tslice]
+                tp = np.array(tau_dat.phase_deg_vals)[tslice]*RADS_PER_DEGS
+                tm = np.array(tau_dat.B_deg_vals)[tslice]*RADS_PER_DEGS
                 tm = np.sin(np.abs(tm))
-                tr = tau_dat.rho_km_vals
-                tt = tau_dat.raw_tau_vals
+                tt = np.array(tau_dat.raw_tau_vals)[tslice]
                 rmin = np.min(tr)
                 rmax = np.max(tr)
                 rfin = int(np.max((rmax-self.rho_km_vals>=0).nonzero()))
@@ -954,6 +1168,7 @@ class ExtractCSVData(object):
                 tm = interp(self.tau_rho)
                 self.power_vals = np.exp(-self.tau_vals/tm)
                 del tau_dat, tp, tm, tr, tt, rmin, rmax, rfin, rstart, interp
+                del n_tau, tslice
         else:
             self.tau_rho = None
             self.tau_vals = None
@@ -972,7 +1187,7 @@ class ExtractCSVData(object):
             "DLP Data": self.dlp
         }
 
-        input_kwds = {"TAU Data": self.tau}
+        input_kwds = {"TAU Data": self.tau, "rng": self.rng}
 
         self.history = write_history_dict(input_vars, input_kwds, __file__)
         var = geo.split("/")[-1]
@@ -1172,7 +1387,10 @@ class PureCSVReader(object):
     def __init__(self, dat):
         if (not isinstance(dat, str)):
             raise TypeError("Text file must be a string.")
-        df = pd.read_csv(dat)
+        if is_binary(dat):
+            df = read_binary(dat)
+        else:
+            df = pd.read_csv(dat)
         self.rho_km_vals      = np.array(df.rho_km_vals)
         self.phase_rad_vals   = np.array(df.phase_rad_vals)
         self.p_norm_vals      = np.array(df.p_norm_vals)
@@ -13,6 +13,10 @@ Purpose:
 
 from .spm_to_et import spm_to_et
 from .et_to_spm import et_to_spm
+from .spice_session import kernel_session
+from . import checkpoint
+from . import columnar
+from . import instrument
 from .CSV_tools import ExtractCSVData
 from .history import write_history_dict as write_history_dict
 from .history import date_to_rev as date_to_rev
@@ -0,0 +1,397 @@
+"""
+batch_scheduler.py
+
+Purpose:
+    Run the files of a batch concurrently on a pool of worker processes.
+    Jobs are started in order of decreasing estimated cost, so that the
+    longest ones (the largest files, such as 16 kHz files) do not end
+    up alone at the end of the batch. Each worker can run an
+    initializer once, e.g. to load the SPICE kernels it will keep for
+    every file it processes. Several batches, on one or more machines,
+    can share the jobs through a ``JobQueue`` on a common file system.
+    A batch can be resumed from the completion (.done) file of an
+    earlier run, or from the failure (.err) file of a batch run before
+    .done files were written.
+
+Dependencies:
+    #. os
+    #. time
+    #. errno
+    #. socket
+    #. traceback
+    #. multiprocessing
+"""
+import os
+import time
+import errno
+import socket
+import traceback
+import multiprocessing
+
+# Set in each worker process by run_batch.
+_worker = {}
+
+def job_cost(rsr_file):
+    """
+    Purpose:
+        Estimate the relative cost of processing an RSR file from its
+        size, which measures the number of samples to read and reduce.
+        Every file of a batch is reconstructed at the same resolution,
+        so the resolution does not change the order of the files.
+
+    Arguments:
+        :rsr_file (*str*): Path to the RSR file.
+
+    Returns:
+        :cost (*float*): Estimated cost, only meaningful relative to
+            the cost of other files.
+    """
+    try:
+        size = float(os.path.getsize(rsr_file))
+    except OSError:
+        # 16 kHz files end in 2 and hold 16 times as many samples
+        if rsr_file[-1] == '2':
+            size = 16.
+        else:
+            size = 1.
+    return size
+
+def read_err_file(err_file):
+    """
+    Purpose:
+        List the files that failed in an earlier run of e2e_batch.py.
+
+    Arguments:
+        :err_file (*str*): Path to the .err file. Each failure is a line
+            of 48 dashes, the path of the file indented by two spaces, a
+            line of 36 dashes, a blank line, 'n=' and the index of the
+            file in the batch list, and then the traceback.
+
+    Returns:
+        :failures (*list*): (path, index) of each failed file, in the
+            order they appear, where index is None if the record has no
+            'n=' line. Empty if err_file does not exist.
+    """
+    if not os.path.exists(err_file):
+        return []
+
+    failures = []
+    lines = open(err_file, 'r').read().split('\n')
+    for i in range(len(lines) - 1):
+        if (lines[i] == '-'*48) and lines[i+1].startswith('  '):
+            rsr_file = lines[i+1].strip()
+            ind = None
+            if (i + 4 < len(lines)) and lines[i+4].startswith('n='):
+                try:
+                    ind = int(lines[i+4][2:])
+                except ValueError:
+                    pass
+            failures.append((rsr_file, ind))
+    return failures
+
+def read_done_file(done_file):
+    """
+    Purpose:
+        List the files that were completed by an earlier run.
+
+    Arguments:
+        :done_file (*str*): Path to the .done file, with one path per
+            line.
+
+    Returns:
+        :files (*set*): Paths of the completed files. Empty if
+            done_file does not exist.
+    """
+    if not os.path.exists(done_file):
+        return set()
+    return set(line.strip() for line in open(done_file, 'r')
+            if line.strip())
+
+def read_legacy_done(err_file, batch_files):
+    """
+    Purpose:
+        Rebuild the files completed by a batch run before .done files
+        were written. That batch processed batch_files one at a time,
+        in order, and wrote the index of every failure to its .err
+        file, so every file before the last failure that did not fail
+        was completed. The batch may have stopped anywhere after the
+        last failure, so nothing after it is known to have completed.
+
+    Arguments:
+        :err_file (*str*): Path to the .err file of the earlier run.
+        :batch_files (*list*): Every file of the batch list, in order,
+            including those that were skipped, as indexed by 'n='.
+
+    Returns:
+        :files (*set*): Paths of the completed files. Empty if err_file
+            does not exist or has no failures.
+    """
+    failed = set()
+    last = -1
+    for rsr_file, ind in read_err_file(err_file):
+        failed.add(rsr_file)
+
+        # Only trust indices that still point to the same file
+        if ((ind is not None) and (0 <= ind < len(batch_files))
+                and (batch_files[ind] == rsr_file)):
+            last = max(last, ind)
+    return set(f for f in batch_files[:last] if f not in failed)
+
+def resume_jobs(files, done_file, err_file=None, batch_files=None):
+    """
+    Purpose:
+        Select the files still to be processed when a batch is resumed.
+        Every file that is not listed in the .done file is run again,
+        which covers both the failures and the files that were never
+        reached. Without a .done file, as for a batch run before .done
+        files were written, the completed files are rebuilt from the
+        .err file (see ``read_legacy_done``), and the others are run
+        again.
+
+    Arguments:
+        :files (*list*): Paths of every file to process in the batch.
+        :done_file (*str*): Path to the .done file of the earlier run.
+
+    Keyword Arguments:
+        :err_file (*str*): Path to the .err file of the earlier run,
+            used if there is no .done file. If None, every file is run
+            again in that case.
+        :batch_files (*list*): Every file of the batch list, in order,
+            as indexed in the .err file. Default is files.
+
+    Returns:
+        :files (*list*): Paths of the files to process, in the order of
+            the input list.
+    """
+    if os.path.exists(done_file) or (err_file is None):
+        done = read_done_file(done_file)
+    else:
+        if batch_files is None:
+            batch_files = files
+        done = read_legacy_done(err_file, batch_files)
+    return [f for f in files if f not in done]
+
+class JobQueue(object):
+    """
+    Purpose:
+        Share the jobs of a batch between several runs, e.g. on
+        different machines, through a directory that all of them can
+        see. A job is claimed by creating a file for it with O_EXCL,
+        which only one run can do, so no job is processed twice.
+
+        A claim holds the host name and process ID of its owner. A claim
+        made on this host by a process that no longer exists, e.g. a
+        worker that was killed, is stale and is taken over by the next
+        run that wants the job. The owner of a claim made on another
+        host cannot be checked, so such a claim is only taken over once
+        it is older than timeout.
+
+    Arguments:
+        :queue_dir (*str*): Directory holding the claim files. It is
+            created if it does not exist.
+
+    Keyword Arguments:
+        :timeout (*float*): Age in seconds after which a claim from
+            another host is stale. It must be longer than the longest
+            job. If None, such claims never expire.
+
+    Example:
+        >>> queue = JobQueue('/shared/queue')
+        >>> if queue.claim(rsr_file):
+        >>>     process(rsr_file)
+        >>>     queue.finish(rsr_file)
+    """
+    def __init__(self, queue_dir, timeout=None):
+        self.queue_dir = queue_dir
+        self.timeout = timeout
+        if not os.path.exists(queue_dir):
+            try:
+                os.makedirs(queue_dir)
+            except OSError:
+                # Another run created it first
+                pass
+
+    def __path(self, job, ext):
+        name = job.replace(os.sep, '_').replace(':', '_')
+        return os.path.join(self.queue_dir, name + ext)
+
+    def claim(self, job):
+        """
+        Purpose:
+            Claim a job.
+
+        Arguments:
+            :job (*str*): Name of the job, e.g. the RSR file path.
+
+        Returns:
+            :claimed (*bool*): True if this run now owns the job, False
+                if another run claimed or finished it first.
+        """
+        if os.path.exists(self.__path(job, '.done')):
+            return False
+        if self.__create(job):
+            return True
+        if not self.__take_stale(job):
+            return False
+        return self.__create(job)
+
+    def __create(self, job):
+        try:
+            fd = os.open(self.__path(job, '.claim'),
+                    os.O_CREAT | os.O_EXCL | os.O_WRONLY)
+        except OSError:
+            return False
+        os.write(fd, ('%s %d\n' % (socket.gethostname(),
+            os.getpid())).encode())
+        os.close(fd)
+        return True
+
+    def __read(self, path):
+        # (host, pid, mtime), with host and pid None if the claim has
+        #   not been written in full
+        try:
+            owner = open(path, 'r').read().split()
+            mtime = os.path.getmtime(path)
+        except (IOError, OSError):
+            return None
+        if (len(owner) != 2) or (not owner[1].isdigit()):
+            return None, None, mtime
+        return owner[0], int(owner[1]), mtime
+
+    def __is_stale(self, claim):
+        host, pid, mtime = claim
+        if (host is not None) and (host == socket.gethostname()):
+            try:
+                os.kill(pid, 0)
+            except OSError as err:
+                # The process exists but belongs to another user
+                return err.errno != errno.EPERM
+            return False
+        if self.timeout is None:
+            return False
+        return (time.time() - mtime) > self.timeout
+
+    def __take_stale(self, job):
+        # Remove a stale claim. It is first moved aside, so that of
+        #   several runs removing it at once only one succeeds, and put
+        #   back if it turns out to be a new claim made in the meantime.
+        path = self.__path(job, '.claim')
+        claim = self.__read(path)
+        if (claim is None) or (not self.__is_stale(claim)):
+            return False
+        stale = path + '.%s_%d' % (socket.gethostname(), os.getpid())
+        try:
+            os.rename(path, stale)
+        except OSError:
+            return False
+        if self.__read(stale) != claim:
+            try:
+                os.link(stale, path)
+            except OSError:
+                pass
+            os.remove(stale)
+            return False
+        os.remove(stale)
+        return True
+
+    def finish(self, job):
+        """
+        Purpose:
+            Mark a claimed job as completed.
+
+        Arguments:
+            :job (*str*): Name of the job.
+        """
+        open(self.__path(job, '.done'), 'w').close()
+        self.release(job)
+
+    def release(self, job):
+        """
+        Purpose:
+            Give up a claimed job, e.g. after it failed, so that a
+            later run can try it again.
+
+        Arguments:
+            :job (*str*): Name of the job.
+        """
+        try:
+            os.remove(self.__path(job, '.claim'))
+        except OSError:
+            pass
+
+def _init_worker(func, queue_dir, queue_timeout, initializer, initargs):
+    _worker['func'] = func
+    if queue_dir is not None:
+        _worker['queue'] = JobQueue(queue_dir, timeout=queue_timeout)
+    else:
+        _worker['queue'] = None
+    if initializer is not None:
+        initializer(*initargs)
+
+def _run_job(job):
+    queue = _worker['queue']
+    if (queue is not None) and (not queue.claim(job)):
+        return job, 'skipped', None
+
+    try:
+        result = _worker['func'](job)
+    except Exception:
+        if queue is not None:
+            queue.release(job)
+        return job, 'failed', traceback.format_exc()
+
+    if queue is not None:
+        queue.finish(job)
+    return job, 'done', result
+
+def run_batch(jobs, func, costs=None, nworkers=1, initializer=None,
+        initargs=(), queue_dir=None, queue_timeout=None):
+    """
+    Purpose:
+        Run func on every job with a pool of worker processes and yield
+        the results as the jobs finish.
+
+    Arguments:
+        :jobs (*list*): Jobs to run, e.g. RSR file paths.
+        :func (*function*): Module level function called as func(job)
+            in a worker process.
+
+    Keyword Arguments:
+        :costs (*list*): Estimated cost of each job (see ``job_cost``).
+            Jobs are started from the most to the least expensive. If
+            None, they are started in the order given.
+        :nworkers (*int*): Number of worker processes. With 1, the jobs
+            run in this process, which is easier to debug.
+        :initializer (*function*): Called once in every worker, before
+            its first job, as initializer(\*initargs).
+        :initargs (*tuple*): Arguments to the initializer.
+        :queue_dir (*str*): Directory of a ``JobQueue`` shared with
+            other runs. Jobs claimed by another run are skipped.
+        :queue_timeout (*float*): Age in seconds after which a claim
+            made on another host is stale (see ``JobQueue``).
+
+    Yields:
+        :result (*tuple*): (job, status, output), where status is
+            'done', 'failed' or 'skipped', and output is the return
+            value of func, the traceback of the failure, or None.
+    """
+    if costs is not None:
+        order = sorted(range(len(jobs)), key=lambda i: -costs[i])
+        jobs = [jobs[i] for i in order]
+
+    if nworkers <= 1:
+        _init_worker(func, queue_dir, queue_timeout, initializer, initargs)
+        for job in jobs:
+            yield _run_job(job)
+        return
+
+    pool = multiprocessing.Pool(nworkers, initializer=_init_worker,
+            initargs=(func, queue_dir, queue_timeout, initializer,
+                initargs))
+    try:
+        # One job at a time, so that workers take them in cost order.
+        for result in pool.imap_unordered(_run_job, jobs, chunksize=1):
+            yield result
+    finally:
+        pool.close()
+        pool.join()
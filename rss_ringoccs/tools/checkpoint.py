@@ -0,0 +1,324 @@
+"""
+checkpoint.py
+
+Purpose:
+    Content-addressed cache of the Geometry, Calibration and
+    DiffractionLimitedProfile instances made from an RSR file, so that a
+    file can be reconstructed again at a different resolution, window
+    or psitype without reading the RSR file, computing the geometry or
+    fitting the frequency offset and power again.
+
+    Every stage is stored under a key that hashes the checksum of the
+    RSR file, the kernels, the keyword arguments of the stage that are
+    recorded in its history, and the key of the stage before it. A
+    product is only reused if all of its inputs are unchanged. Products
+    are stored as uncompressed .npz files: the numpy arrays of the
+    instance as they are, and the remaining attributes as a pickle.
+
+Dependencies:
+    #. os
+    #. io
+    #. hashlib
+    #. pickle
+    #. numpy
+"""
+import os
+import io
+import hashlib
+import pickle
+import numpy as np
+
+# Change whenever the stored products are no longer compatible.
+CACHE_VERSION = 1
+
+# Checksums of RSR files, keyed by (path, size, modification time).
+_checksums = {}
+
+def file_checksum(path, block_size=1 << 24):
+    """
+    Purpose:
+        SHA-1 checksum of the contents of a file. The result is kept
+        for the lifetime of the process, so each file is only read once
+        unless it changes.
+
+    Arguments:
+        :path (*str*): Path to the file.
+
+    Keyword Arguments:
+        :block_size (*int*): Number of bytes read at a time.
+
+    Returns:
+        :checksum (*str*): Hexadecimal digest.
+    """
+    stat = os.stat(path)
+    ident = (os.path.abspath(path), stat.st_size, stat.st_mtime)
+    if ident not in _checksums:
+        sha = hashlib.sha1()
+        with open(path, 'rb') as f:
+            block = f.read(block_size)
+            while block:
+                sha.update(block)
+                block = f.read(block_size)
+        _checksums[ident] = sha.hexdigest()
+    return _checksums[ident]
+
+def kernels_checksum(kernels):
+    """
+    Purpose:
+        Checksum of a kernel set. A meta-kernel or kernel list is
+        identified by its contents, and every other kernel by its path,
+        size and modification time, since SPK files can be very large.
+
+    Arguments:
+        :kernels (*str* or *list*): Path to a meta-kernel or list of
+            paths to kernels.
+
+    Returns:
+        :checksum (*str*): Hexadecimal digest.
+    """
+    if isinstance(kernels, str):
+        kernels = [kernels]
+
+    sha = hashlib.sha1()
+    for kernel in kernels:
+        if kernel.lower().endswith(('.ker', '.tm', '.txt')):
+            sha.update(file_checksum(kernel).encode())
+        else:
+            stat = os.stat(kernel)
+            sha.update(('%s %d %f' % (os.path.abspath(kernel), stat.st_size,
+                stat.st_mtime)).encode())
+    return sha.hexdigest()
+
+class StageCache(object):
+    """
+    Purpose:
+        Store and retrieve processing products by key.
+
+    Arguments:
+        :cache_dir (*str*): Directory holding the products. It is created
+            if it does not exist.
+
+    Attributes:
+        :cache_dir (*str*): See arguments.
+        :hits (*int*): Number of products found.
+        :misses (*int*): Number of products that were not found.
+
+    Example:
+        >>> cache = StageCache('../output/checkpoints')
+        >>> key = cache.key('geo', rsr_key, planet='Saturn')
+        >>> geo_inst = cache.load('geo', key)
+        >>> if geo_inst is None:
+        >>>     geo_inst = Geometry(rsr_inst, 'Saturn', 'Cassini', kernels)
+        >>>     cache.save('geo', key, geo_inst)
+    """
+    def __init__(self, cache_dir):
+        self.cache_dir = cache_dir
+        self.hits = 0
+        self.misses = 0
+        if not os.path.exists(cache_dir):
+            try:
+                os.makedirs(cache_dir)
+            except OSError:
+                # Another process created it first
+                pass
+
+    def key(self, stage, parent, **kwds):
+        """
+        Purpose:
+            Key of a product.
+
+        Arguments:
+            :stage (*str*): Name of the stage, e.g. 'geo'.
+            :parent (*str*): Key of the stage the product is made from,
+                or a checksum of the raw input.
+
+        Keyword Arguments:
+            Any inputs of the stage that change its output. Values are
+            compared by their repr, in order of their names.
+
+        Returns:
+            :key (*str*): Hexadecimal digest.
+        """
+        items = ['%s=%r' % (name, kwds[name]) for name in sorted(kwds)]
+        text = '%d|%s|%s|%s' % (CACHE_VERSION, stage, parent,
+                '|'.join(items))
+        return hashlib.sha1(text.encode()).hexdigest()
+
+    def __path(self, stage, key):
+        return os.path.join(self.cache_dir, '%s_%s.npz' % (stage, key))
+
+    def save(self, stage, key, inst):
+        """
+        Purpose:
+            Store an instance. The file is written under a temporary
+            name and then renamed, so that a product is never read while
+            it is being written by another process.
+
+        Arguments:
+            :stage (*str*): Name of the stage.
+            :key (*str*): Key of the product.
+            :inst (*object*): Instance to store, or None to record that
+                the stage has no output for these inputs, as for the
+                missing direction of a one-sided occultation.
+        """
+        arrays = {}
+        attrs = {}
+        if inst is not None:
+            for name, value in vars(inst).items():
+                if isinstance(value, np.ndarray) and (value.dtype != object):
+                    arrays[name] = value
+                else:
+                    attrs[name] = value
+            meta = (type(inst), attrs)
+        else:
+            meta = None
+        arrays['__meta__'] = np.frombuffer(
+                pickle.dumps(meta, protocol=pickle.HIGHEST_PROTOCOL),
+                dtype=np.uint8)
+
+        path = self.__path(stage, key)
+        tmp = '%s.%d.tmp' % (path, os.getpid())
+        with open(tmp, 'wb') as f:
+            np.savez(f, **arrays)
+        os.replace(tmp, path)
+
+    def load(self, stage, key):
+        """
+        Purpose:
+            Retrieve an instance.
+
+        Arguments:
+            :stage (*str*): Name of the stage.
+            :key (*str*): Key of the product.
+
+        Returns:
+            :found (*bool*): True if the product is in the cache.
+            :inst (*object*): The stored instance, or None.
+        """
+        path = self.__path(stage, key)
+        if not os.path.exists(path):
+            self.misses += 1
+            return False, None
+
+        with np.load(path) as data:
+            meta = pickle.loads(data['__meta__'].tobytes())
+            if meta is None:
+                inst = None
+            else:
+                cls, attrs = meta
+                inst = cls.__new__(cls)
+                inst.__dict__.update(attrs)
+                for name in data.files:
+                    if name != '__meta__':
+                        setattr(inst, name, data[name])
+        self.hits += 1
+        return True, inst
+
+    def stats(self):
+        """
+        Purpose:
+            Summary of the cache for printing.
+
+        Returns:
+            :stats (*dict*): Dictionary with keys "hits" and "misses".
+        """
+        return {"hits": self.hits, "misses": self.misses}
+
+def create_products(rsr_file, kernels, dr_km, cache=None, planet='Saturn',
+        spacecraft='Cassini', pt_per_sec=1., decimate_16khz_to_1khz=True,
+        decimate_mode='scipy', fof_order=9, pnf_order=3, dt_cal=1.0,
+        pnf_fittype='poly', interact=False,
+        profile_range=[65000., 150000.], verbose=False, write_file=True):
+    """
+    Purpose:
+        Run RSRReader, Geometry, Calibration and
+        DiffractionLimitedProfile.create_dlps on an RSR file, reusing
+        the products in a cache when their inputs have not changed. The
+        RSR file is only read when the geometry, the calibration or the
+        profiles have to be computed.
+
+    Arguments:
+        :rsr_file (*str*): Path to the RSR file.
+        :kernels (*str* or *list*): Path to a meta-kernel or list of paths
+            to kernels.
+        :dr_km (*float*): Radial sampling of the DLP in km.
+
+    Keyword Arguments:
+        :cache (*object*): Instance of StageCache. If None, nothing is
+            cached and every stage is run.
+        Every other keyword is passed to the stage it belongs to (see
+        RSRReader, Geometry, Calibration and DiffractionLimitedProfile).
+        With interact=True the calibration depends on the user, so it
+        and the profiles are never taken from or put in the cache.
+
+    Returns:
+        :geo_inst (*object*): Instance of Geometry.
+        :cal_inst (*object*): Instance of Calibration.
+        :dlp_inst_ing (*object*): Ingress DiffractionLimitedProfile or
+            None.
+        :dlp_inst_egr (*object*): Egress DiffractionLimitedProfile or
+            None.
+
+    Notes:
+        #. Output files of a stage are only written when the stage is
+            run, not when it is taken from the cache.
+    """
+    from ..rsr_reader import RSRReader
+    from ..occgeo import Geometry
+    from ..calibration import Calibration, DiffractionLimitedProfile
+
+    if cache is not None:
+        rsr_key = cache.key('rsr', file_checksum(rsr_file),
+                decimate_16khz_to_1khz=decimate_16khz_to_1khz,
+                decimate_mode=decimate_mode)
+        geo_key = cache.key('geo', rsr_key, kernels=kernels_checksum(kernels),
+                planet=planet, spacecraft=spacecraft, pt_per_sec=pt_per_sec)
+        cal_key = cache.key('cal', geo_key, fof_order=fof_order,
+                pnf_order=pnf_order, dt_cal=dt_cal, pnf_fittype=pnf_fittype)
+        dlp_key = cache.key('dlp', cal_key, dr_km=dr_km,
+                profile_range=list(profile_range))
+
+        geo_hit, geo_inst = cache.load('geo', geo_key)
+        if interact:
+            cal_hit = ing_hit = egr_hit = False
+        else:
+            cal_hit, cal_inst = cache.load('cal', cal_key)
+            ing_hit, dlp_inst_ing = cache.load('dlp_ing', dlp_key)
+            egr_hit, dlp_inst_egr = cache.load('dlp_egr', dlp_key)
+
+        if geo_hit and cal_hit and ing_hit and egr_hit:
+            if verbose:
+                print('Using cached geometry, calibration and profiles...')
+            return geo_inst, cal_inst, dlp_inst_ing, dlp_inst_egr
+    else:
+        geo_hit = cal_hit = False
+
+    rsr_inst = RSRReader(rsr_file, verbose=verbose,
+            decimate_16khz_to_1khz=decimate_16khz_to_1khz,
+            decimate_mode=decimate_mode)
+
+    if not geo_hit:
+        geo_inst = Geometry(rsr_inst, planet, spacecraft, kernels,
+                pt_per_sec=pt_per_sec, verbose=verbose, write_file=write_file)
+        if cache is not None:
+            cache.save('geo', geo_key, geo_inst)
+
+    if not cal_hit:
+        cal_inst = Calibration(rsr_inst, geo_inst, verbose=verbose,
+                write_file=write_file, fof_order=fof_order,
+                pnf_order=pnf_order, dt_cal=dt_cal, pnf_fittype=pnf_fittype,
+                interact=interact)
+
+        # Saved before create_dlps, which trims IQ_c in place
+        if (cache is not None) and (not interact):
+            cache.save('cal', cal_key, cal_inst)
+
+    dlp_inst_ing, dlp_inst_egr = DiffractionLimitedProfile.create_dlps(
+            rsr_inst, geo_inst, cal_inst, dr_km, profile_range=profile_range,
+            write_file=write_file, verbose=verbose)
+
+    if (cache is not None) and (not interact):
+        cache.save('dlp_ing', dlp_key, dlp_inst_ing)
+        cache.save('dlp_egr', dlp_key, dlp_inst_egr)
+
+    return geo_inst, cal_inst, dlp_inst_ing, dlp_inst_egr
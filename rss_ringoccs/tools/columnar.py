@@ -0,0 +1,140 @@
+"""
+columnar.py
+
+Purpose:
+    Binary columnar copies of the GEO, CAL, DLP and TAU products,
+    written next to the PDS3 .TAB files from the same arrays, so that
+    comparisons and reprocessing can read the data without formatting
+    or parsing text.
+
+    A product is a .npz file with one float64 array per column of the
+    .TAB file, named as in CSV_tools. By default the file is not
+    compressed, and each column is memory-mapped directly from the file
+    when read, so only the pages that are used are loaded. The file is a
+    standard .npz archive and can also be opened with numpy.load.
+    Compressed files are smaller, but a column has to be decompressed
+    in full the first time it is used.
+
+Dependencies:
+    #. zipfile
+    #. numpy
+"""
+import zipfile
+import numpy as np
+
+def write_columns(out_file, columns, compress=False):
+    """
+    Purpose:
+        Write the columns of a product to a .npz file.
+
+    Arguments:
+        :out_file (*str*): Path to the output file, including the .NPZ
+            extension.
+        :columns (*list*): List of (name, array) pairs, in the order of
+            the columns of the .TAB file.
+
+    Keyword Arguments:
+        :compress (*bool*): Compress the columns. Compressed columns
+            cannot be memory-mapped.
+    """
+    arrays = {}
+    for name, array in columns:
+        arrays[name] = np.ascontiguousarray(array, dtype=np.float64)
+
+    print('\tWriting binary columns to: \n\t\t'
+            + '/'.join(out_file.split('/')[0:5]) + '/\n\t\t\t'
+            + '/'.join(out_file.split('/')[5:]))
+
+    # Given a name, numpy.savez would add .npz to the upper case extension
+    with open(out_file, 'wb') as f:
+        if compress:
+            np.savez_compressed(f, **arrays)
+        else:
+            np.savez(f, **arrays)
+    return None
+
+class ColumnSet(object):
+    """
+    Purpose:
+        Columns of a product read by read_columns. Each column is an
+        attribute, as with the pandas DataFrame returned by the CSV
+        readers, so that either can be used in ExtractCSVData.
+
+    Attributes:
+        :names (*list*): Names of the columns, in file order.
+        :file (*str*): Path to the file.
+    """
+    def __init__(self, file, names, arrays):
+        self.file = file
+        self.names = names
+        for name in names:
+            setattr(self, name, arrays[name])
+
+    def __getitem__(self, name):
+        return getattr(self, name)
+
+    def __len__(self):
+        if len(self.names) == 0:
+            return 0
+        return len(getattr(self, self.names[0]))
+
+def _member_offset(f, info):
+    # The local header can have a different extra field than the
+    #   central directory, so its length is read from the header.
+    f.seek(info.header_offset)
+    header = f.read(30)
+    if header[0:4] != b'PK\x03\x04':
+        raise ValueError("Bad zip member: %s" % info.filename)
+    name_len = int.from_bytes(header[26:28], 'little')
+    extra_len = int.from_bytes(header[28:30], 'little')
+    f.seek(info.header_offset + 30 + name_len + extra_len)
+
+    version = np.lib.format.read_magic(f)
+    if version == (1, 0):
+        shape, fortran, dtype = np.lib.format.read_array_header_1_0(f)
+    else:
+        shape, fortran, dtype = np.lib.format.read_array_header_2_0(f)
+    return f.tell(), shape, fortran, dtype
+
+def read_columns(in_file, mmap=True):
+    """
+    Purpose:
+        Read the columns of a product written by write_columns.
+
+    Arguments:
+        :in_file (*str*): Path to the .npz file.
+
+    Keyword Arguments:
+        :mmap (*bool*): Memory-map the columns, read-only. Compressed
+            columns are always read into memory.
+
+    Returns:
+        :columns (*object*): Instance of ColumnSet.
+    """
+    arrays = {}
+    names = []
+    with zipfile.ZipFile(in_file, 'r') as zf:
+        infos = [info for info in zf.infolist()
+                if info.filename.endswith('.npy')]
+
+    with open(in_file, 'rb') as f:
+        for info in infos:
+            name = info.filename[:-4]
+            names.append(name)
+            if mmap and (info.compress_type == zipfile.ZIP_STORED):
+                offset, shape, fortran, dtype = _member_offset(f, info)
+                if np.prod(shape) == 0:
+                    # An empty file cannot be memory-mapped
+                    arrays[name] = np.zeros(shape, dtype=dtype)
+                    continue
+                arrays[name] = np.memmap(in_file, dtype=dtype, mode='r',
+                        offset=offset, shape=shape,
+                        order='F' if fortran else 'C')
+
+    missing = [name for name in names if name not in arrays]
+    if missing:
+        with np.load(in_file) as data:
+            for name in missing:
+                arrays[name] = data[name]
+
+    return ColumnSet(in_file, names, arrays)
@@ -543,6 +543,14 @@ def galleryplots(rev, geo, cal, dlp, tau=None, res=[1.0], rng="all",
     N_Plots = len(res)
     N_Pages = int(N_Plots/4.0)
 
+    # Perform all of the reconstructions in one pass over the data.
+    batch = diffrec.DiffractionCorrection.batch(data, res, wtypes=wtype,
+                                                rng=rng, psitype=psitype,
+                                                norm=norm, bfac=bfac,
+                                                sigma=sigma,
+                                                res_factor=res_factor,
+                                                verbose=verbose)
+
     with PdfPages(outfile) as pdf:
         for i_page in range(N_Pages):
             plt.rc('font', family='serif')
@@ -551,16 +559,11 @@ def galleryplots(rev, geo, cal, dlp, tau=None, res=[1.0], rng="all",
             plt.suptitle("Resolution Comparison: %s" % (rev), size=14)
             gs = gridspec.GridSpec(4, 1, hspace=0.0)
 
-            # Perform Reconstructions
+            # Plot Reconstructions
             for i in range(4):
                 i_res = int(4*i_page+i)
                 sres = str(res[i_res])+"km Reconstruction"
-                rec = diffrec.DiffractionCorrection(data, res[i_res],
-                                                    wtype=wtype, rng=rng,
-                                                    psitype=psitype, norm=norm,
-                                                    bfac=bfac, sigma=sigma,
-                                                    res_factor=res_factor,
-                                                    verbose=verbose)
+                rec = batch.profiles[0][i_res]
                 plt.subplot(gs[i, 0])
                 plt.tick_params(axis='y', which='both', left=True,
                                 right=True, labelleft=True)
@@ -602,12 +605,7 @@ def galleryplots(rev, geo, cal, dlp, tau=None, res=[1.0], rng="all",
             for i in range(int(N_Plots % 4)):
                 i_res = int(4*N_Pages+i)
                 sres = str(res[i_res])+"km Reconstruction"
-                rec = diffrec.DiffractionCorrection(data, res[i_res],
-                                                    wtype=wtype, rng=rng,
-                                                    psitype=psitype, norm=norm,
-                                                    bfac=bfac, sigma=sigma,
-                                                    res_factor=res_factor,
-                                                    verbose=verbose)
+                rec = batch.profiles[0][i_res]
                 plt.subplot(gs[i, 0])
                 plt.tick_params(axis='y', which='both', left=True,
                                 right=True, labelleft=True)
@@ -16,6 +16,7 @@ from .write_output_files import construct_filepath
 import pdb
 import time
 import spiceypy as spice
+from .spice_session import kernel_session
 
 sat_radius =  60268.
 rings_km = [74490., 91983., 117516., 122052., 136774., 139826.]
@@ -110,8 +111,7 @@ def plot_occ_earth_view(pdf, geo_inst):
     plt.axes().set_aspect('equal')
 
     kernels = geo_inst.history['Positional Args']['kernels']
-    spice.kclear()
-    spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     t_oet_et_vals = geo_inst.t_oet_et_vals
     oet_et_start = t_oet_et_vals[0]
@@ -12,6 +12,7 @@ Dependencies:
 
 import numpy as np
 import spiceypy as spice
+from .spice_session import kernel_session
 
 def et_to_spm(et_vals, kernels=None, ref_doy=None):
     """
@@ -28,9 +29,7 @@ def et_to_spm(et_vals, kernels=None, ref_doy=None):
     Returns:
         :spm_vals (*float* or *np.ndarray*): Seconds past midnight
     """
-    if kernels:
-        spice.kclear()
-        spice.furnsh(kernels)
+    kernel_session.load(kernels)
     if isinstance(et_vals, float):
         npts = 1
         et_vals = [et_vals]
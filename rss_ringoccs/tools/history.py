@@ -18,6 +18,7 @@ import platform
 import os
 import numpy as np
 import pandas as pd
+from . import instrument
 
 def date_to_rev(year, doy, 
         rss_file='../tables/RSSActivities_before_USOfailure_rings_only.txt'):
@@ -135,7 +136,9 @@ def write_history_dict(input_vars, input_kwds, source_file, add_info=None):
         :history (*dict*): Dictionary with keys: "User Name", "Host Name",
                             "Run Date", "Python Version", "Operating System",
                             "Source File", "Positional Args", 
-                            "Keyword Args"
+                            "Keyword Args", "Additional Info", and
+                            "Instrumentation" if instrumentation is
+                            enabled
 
     """
 
@@ -165,5 +168,9 @@ def write_history_dict(input_vars, input_kwds, source_file, add_info=None):
         history["Additional Info"] = add_info
     else:
         history["Additional Info"] = ''
+
+    # Timers and counters of the process so far, see instrument.py
+    if instrument.enabled():
+        history["Instrumentation"] = instrument.report()
     return history
 
@@ -0,0 +1,281 @@
+"""
+instrument.py
+
+Purpose:
+    Timers and counters for the stages of the pipeline. Instrumentation
+    is off until enable() is called. While it is off, timer() returns a
+    shared object that does nothing, count() returns at once, and
+    functions wrapped with timed() only pay for one extra call, so the
+    hooks can stay in the hot paths.
+
+    While it is on, every timer records the number of calls and the
+    total and largest time spent, and every counter its sum. report()
+    summarizes both with the peak resident memory of the process, and
+    is added to every history dictionary made by write_history_dict, so
+    it is kept with each product. The summary can also be written as
+    JSON, and with enable(trace=True) every timed span is kept and can
+    be written in the Chrome trace format, to be viewed in
+    chrome://tracing or Perfetto.
+
+    The totals are for the whole process since enable() or reset(). In
+    a batch on a pool of workers (see batch_scheduler), each worker has
+    its own. The peak memory is not reset: it is the largest resident
+    memory since the process started, so it can come from an earlier
+    stage or file than the timers it is reported with.
+
+Dependencies:
+    #. os
+    #. sys
+    #. time
+    #. json
+    #. functools
+    #. threading
+"""
+import os
+import sys
+import time
+import json
+import functools
+import threading
+
+try:
+    import resource
+except ImportError:
+    # Not available on Windows
+    resource = None
+
+_state = {'enabled': False, 'trace': False}
+
+# Timer name: [calls, total seconds, largest seconds]
+_timers = {}
+
+# Counter name: sum
+_counters = {}
+
+# Timed spans for the trace: (name, start, duration, thread)
+_events = []
+
+_lock = threading.Lock()
+_origin = [time.perf_counter()]
+
+def enable(trace=False):
+    """
+    Purpose:
+        Start recording timers and counters.
+
+    Keyword Arguments:
+        :trace (*bool*): Also keep every timed span, for
+            export_chrome_trace. The memory used grows with the number
+            of spans.
+    """
+    _state['enabled'] = True
+    _state['trace'] = trace
+
+def disable():
+    """
+    Purpose:
+        Stop recording. What was recorded is kept until reset().
+    """
+    _state['enabled'] = False
+    _state['trace'] = False
+
+def enabled():
+    """
+    Purpose:
+        Whether timers and counters are being recorded.
+
+    Returns:
+        :enabled (*bool*): True after enable().
+    """
+    return _state['enabled']
+
+def reset():
+    """
+    Purpose:
+        Forget every timer, counter and span.
+    """
+    with _lock:
+        _timers.clear()
+        _counters.clear()
+        del _events[:]
+        _origin[0] = time.perf_counter()
+
+class _NullTimer(object):
+    __slots__ = ()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        return False
+
+_null_timer = _NullTimer()
+
+class _Timer(object):
+    __slots__ = ('name', 'start')
+
+    def __init__(self, name):
+        self.name = name
+
+    def __enter__(self):
+        self.start = time.perf_counter()
+        return self
+
+    def __exit__(self, *exc):
+        dt = time.perf_counter() - self.start
+        with _lock:
+            stat = _timers.get(self.name)
+            if stat is None:
+                _timers[self.name] = [1, dt, dt]
+            else:
+                stat[0] += 1
+                stat[1] += dt
+                if dt > stat[2]:
+                    stat[2] = dt
+            if _state['trace']:
+                _events.append((self.name, self.start, dt,
+                    threading.current_thread().ident))
+        return False
+
+def timer(name):
+    """
+    Purpose:
+        Time a block of code.
+
+    Arguments:
+        :name (*str*): Name of the timer, e.g. 'occgeo.sincpt_loop'.
+
+    Returns:
+        :timer (*object*): Context manager.
+
+    Example:
+        >>> with instrument.timer('calibration.resample_IQ'):
+        >>>     IQ = resample(IQ)
+    """
+    if not _state['enabled']:
+        return _null_timer
+    return _Timer(name)
+
+def timed(name):
+    """
+    Purpose:
+        Decorator that times every call of a function.
+
+    Arguments:
+        :name (*str*): Name of the timer.
+    """
+    def decorator(func):
+        @functools.wraps(func)
+        def wrapper(*args, **kwargs):
+            if not _state['enabled']:
+                return func(*args, **kwargs)
+            with _Timer(name):
+                return func(*args, **kwargs)
+        return wrapper
+    return decorator
+
+def count(name, n=1):
+    """
+    Purpose:
+        Add to a counter.
+
+    Arguments:
+        :name (*str*): Name of the counter, e.g. 'rsr_reader.bytes_read'.
+
+    Keyword Arguments:
+        :n (*int* or *float*): Amount to add.
+    """
+    if not _state['enabled']:
+        return
+    with _lock:
+        _counters[name] = _counters.get(name, 0) + n
+
+def peak_rss_bytes():
+    """
+    Purpose:
+        Largest resident memory of this process since it started,
+        from ru_maxrss. It never decreases, and is not affected by
+        reset(), so it is not the memory used by one stage.
+
+    Returns:
+        :peak (*int*): Bytes, or None where it is not available.
+    """
+    if resource is None:
+        return None
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+
+    # Kilobytes on Linux, bytes on macOS
+    if sys.platform == 'darwin':
+        return int(peak)
+    return int(peak) * 1024
+
+def report():
+    """
+    Purpose:
+        Summary of what has been recorded.
+
+    Returns:
+        :report (*dict*): Dictionary with keys "timers", with the calls,
+            total and largest time in seconds of each timer, "counters",
+            and "peak_rss_bytes", the peak resident memory over the
+            lifetime of the process (see peak_rss_bytes).
+    """
+    with _lock:
+        timers = dict((name, {'calls': stat[0],
+                              'total_sec': stat[1],
+                              'max_sec': stat[2]})
+                for name, stat in _timers.items())
+        counters = dict(_counters)
+    return {'timers': timers, 'counters': counters,
+            'peak_rss_bytes': peak_rss_bytes()}
+
+def print_report():
+    """
+    Purpose:
+        Print the timers, slowest first, and the counters.
+    """
+    rep = report()
+    print('%-40s %8s %12s %12s' % ('timer', 'calls', 'total (s)',
+        'max (s)'))
+    for name, stat in sorted(rep['timers'].items(),
+            key=lambda item: -item[1]['total_sec']):
+        print('%-40s %8d %12.4f %12.4f' % (name, stat['calls'],
+            stat['total_sec'], stat['max_sec']))
+    for name in sorted(rep['counters']):
+        print('%-40s %12g' % (name, rep['counters'][name]))
+    if rep['peak_rss_bytes'] is not None:
+        print('%-40s %12.1f' % ('peak RSS, process lifetime (MB)',
+            rep['peak_rss_bytes'] / 2.**20))
+
+def export_json(path):
+    """
+    Purpose:
+        Write report() to a JSON file.
+
+    Arguments:
+        :path (*str*): Path to the output file.
+    """
+    with open(path, 'w') as f:
+        json.dump(report(), f, indent=2, sort_keys=True)
+
+def export_chrome_trace(path):
+    """
+    Purpose:
+        Write the timed spans, recorded with enable(trace=True), in the
+        Chrome trace event format. The counters and peak memory are
+        added as metadata.
+
+    Arguments:
+        :path (*str*): Path to the output file.
+    """
+    pid = os.getpid()
+    with _lock:
+        events = [{'name': name, 'ph': 'X', 'pid': pid, 'tid': tid,
+                   'ts': (start - _origin[0]) * 1.e6, 'dur': dt * 1.e6}
+                for name, start, dt, tid in _events]
+    rep = report()
+    with open(path, 'w') as f:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ms',
+                   'otherData': {'counters': rep['counters'],
+                                 'peak_rss_bytes': rep['peak_rss_bytes']}},
+                  f)
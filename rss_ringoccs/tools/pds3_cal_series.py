@@ -20,6 +20,23 @@ import numpy as np
 import pdb
 import time
 
+def get_cal_series_columns(cal_inst):
+    """
+    This returns the columns of a CAL data file, in order, with the names
+    used by CSV_tools.get_cal.
+
+    Arguments
+        :cal_inst (*class*): Instance of Calibration class
+
+    Returns
+        :columns (*list*): List of (name, array) pairs
+    """
+    return [
+            ('spm_vals', cal_inst.t_oet_spm_vals),
+            ('f_sky_pred_vals', cal_inst.f_sky_hz_vals),
+            ('f_sky_resid_fit_vals', cal_inst.f_sky_resid_fit_vals),
+            ('p_free_vals', cal_inst.p_free_vals)]
+
 def write_cal_series_data(cal_inst, out_file):
     """
     This writes a CAL data file with columns: observed event time,
@@ -29,19 +46,10 @@ def write_cal_series_data(cal_inst, out_file):
         :cal_inst (*class*): Instance of Calibration class
         :out_file (*str*): Path to output file
     """
-    format_str = ('%14.6F,' + '%20.6F,' + '%10.6F,' + '%14.6F' + '%s')
-    npts = len(cal_inst.t_oet_spm_vals)
+    format_str = ('%14.6F,' + '%20.6F,' + '%10.6F,' + '%14.6F')
+    columns = [col for name, col in get_cal_series_columns(cal_inst)]
     print('\tWriting CAL data to: \n\t\t' + '/'.join(out_file.split('/')[0:5]) + '/\n\t\t\t' + '/'.join(out_file.split('/')[5:]))
-    f = open(out_file, 'w')
-    for n in range(npts):
-        f.write(format_str % (
-            cal_inst.t_oet_spm_vals[n],
-            cal_inst.f_sky_hz_vals[n],
-            cal_inst.f_sky_resid_fit_vals[n],
-            cal_inst.p_free_vals[n],
-            '\r\n'))
-
-    f.close()
+    pds3.pds3_write_series_data(columns, format_str, out_file)
 
     return None
 
@@ -15,6 +15,37 @@ import pdb
 import time
 from . import pds3_write_series_v2 as pds3
 
+def get_dlp_series_columns(dlp_inst):
+    """
+    This returns the columns of a DLP data file, in order, with the names
+    used by CSV_tools.get_dlp.
+
+    Arguments:
+        :dlp_inst (*class*): Instance of DiffractionLimitedProfile class
+
+    Returns:
+        :columns (*list*): List of (name, array) pairs
+    """
+    # Compute normalized optical depth -- NOTE: this should be added to dlp_inst
+    #   as an attribute
+    tau_norm_vals = -np.sin(abs(dlp_inst.B_rad_vals)) * np.log(
+            dlp_inst.p_norm_vals)
+
+    return [
+            ('rho_km_vals', dlp_inst.rho_km_vals),
+            ('rho_corr_pole_km_vals', dlp_inst.rho_corr_pole_km_vals),
+            ('rho_corr_timing_km_vals', dlp_inst.rho_corr_timing_km_vals),
+            ('phi_rl_deg_vals', np.degrees(dlp_inst.phi_rl_rad_vals)),
+            ('phi_ora_deg_vals', np.degrees(dlp_inst.phi_rad_vals)),
+            ('p_norm_vals', dlp_inst.p_norm_vals),
+            ('raw_tau_vals', tau_norm_vals),
+            ('phase_deg_vals', np.degrees(dlp_inst.phase_rad_vals)),
+            ('raw_tau_threshold_vals', dlp_inst.raw_tau_threshold_vals),
+            ('t_oet_spm_vals', dlp_inst.t_oet_spm_vals),
+            ('t_ret_spm_vals', dlp_inst.t_ret_spm_vals),
+            ('t_set_spm_vals', dlp_inst.t_set_spm_vals),
+            ('B_deg_vals', np.degrees(dlp_inst.B_rad_vals))]
+
 def write_dlp_series_data(dlp_inst, out_file):
     """
     This writes a CAL data file with columns: ring radius, radius correction
@@ -29,36 +60,14 @@ def write_dlp_series_data(dlp_inst, out_file):
     """
     format_str = ('%14.6F,' + '%10.6F,' + '%10.6F,' + '%12.6F,' + '%12.6F,'
             + '%14.6E,' + '%14.6E,' + '%12.6F,' + '%14.6E,' + '%14.6F,'
-            + '%14.6F,' + '%14.6F,' + '%12.6F' + '%s')
+            + '%14.6F,' + '%14.6F,' + '%12.6F')
 
 
-    npts = len(dlp_inst.t_oet_spm_vals)
+    columns = [col for name, col in get_dlp_series_columns(dlp_inst)]
 
-    # Compute normalized optical depth -- NOTE: this should be added to dlp_inst
-    #   as an attribute
-    tau_norm_vals = -np.sin(abs(dlp_inst.B_rad_vals)) * np.log(
-            dlp_inst.p_norm_vals)
     print('\tWriting DLP data to: \n\t\t' + '/'.join(out_file.split('/')[0:5]) + '/\n\t\t\t' + '/'.join(out_file.split('/')[5:]))
 
-    f = open(out_file, 'w')
-    for n in range(npts):
-        f.write(format_str % (
-            dlp_inst.rho_km_vals[n],
-            dlp_inst.rho_corr_pole_km_vals[n],
-            dlp_inst.rho_corr_timing_km_vals[n],
-            np.degrees(dlp_inst.phi_rl_rad_vals[n]),
-            np.degrees(dlp_inst.phi_rad_vals[n]),
-            dlp_inst.p_norm_vals[n],
-            tau_norm_vals[n],
-            np.degrees(dlp_inst.phase_rad_vals[n]),
-            dlp_inst.raw_tau_threshold_vals[n],
-            dlp_inst.t_oet_spm_vals[n],
-            dlp_inst.t_ret_spm_vals[n],
-            dlp_inst.t_set_spm_vals[n],
-            np.degrees(dlp_inst.B_rad_vals[n]),
-            '\r\n'))
-            
-    f.close()
+    pds3.pds3_write_series_data(columns, format_str, out_file)
 
 
     return None
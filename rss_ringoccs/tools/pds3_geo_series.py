@@ -19,6 +19,38 @@ from . import pds3_write_series_v2 as pds3
 import numpy as np
 
 
+def get_geo_series_columns(geo_inst):
+    """
+    This returns the columns of a GEO data file, in order, with the names
+    used by CSV_tools.get_geo.
+
+    Arguments:
+        :geo_inst (*class*): Instance of Geometry class
+
+    Returns:
+        :columns (*list*): List of (name, array) pairs
+    """
+    return [
+            ('t_oet_spm_vals', geo_inst.t_oet_spm_vals),
+            ('t_ret_spm_vals', geo_inst.t_ret_spm_vals),
+            ('t_set_spm_vals', geo_inst.t_set_spm_vals),
+            ('rho_km_vals', geo_inst.rho_km_vals),
+            ('phi_rl_deg_vals', geo_inst.phi_rl_deg_vals),
+            ('phi_ora_deg_vals', geo_inst.phi_ora_deg_vals),
+            ('B_deg_vals', geo_inst.B_deg_vals),
+            ('D_km_vals', geo_inst.D_km_vals),
+            ('rho_dot_kms_vals', geo_inst.rho_dot_kms_vals),
+            ('phi_rl_dot_kms_vals', geo_inst.phi_rl_dot_kms_vals),
+            ('F_km_vals', geo_inst.F_km_vals),
+            ('R_imp_km_vals', geo_inst.R_imp_km_vals),
+            ('rx_km_vals', geo_inst.rx_km_vals),
+            ('ry_km_vals', geo_inst.ry_km_vals),
+            ('rz_km_vals', geo_inst.rz_km_vals),
+            ('vx_kms_vals', geo_inst.vx_kms_vals),
+            ('vy_kms_vals', geo_inst.vy_kms_vals),
+            ('vz_kms_vals', geo_inst.vz_kms_vals),
+            ('obs_spacecract_lat_deg_vals', geo_inst.elev_deg_vals)]
+
 def write_geo_series_data(geo_inst, out_file):
     """
     This writes a GEO data file with columns: observed event time, ring
@@ -35,36 +67,12 @@ def write_geo_series_data(geo_inst, out_file):
         :out_file (*str*): Path to output file
     """
     format_str = ('%14.6F,'*4 + '%12.6F,'*3 + '%16.6F,' + '%14.6F,'*4
-                  + '%16.6F,'*3 + '%14.6F,'*3 + '%12.6F' + '%s')
+                  + '%16.6F,'*3 + '%14.6F,'*3 + '%12.6F')
 
-    npts = len(geo_inst.t_oet_spm_vals)
+    columns = [col for name, col in get_geo_series_columns(geo_inst)]
 
     print('\tWriting GEO data to: \n\t\t' + '/'.join(out_file.split('/')[0:5]) + '/\n\t\t\t' + '/'.join(out_file.split('/')[5:]))
-    f = open(out_file, 'w')
-
-    for n in range(npts):
-        f.write(format_str % (
-            geo_inst.t_oet_spm_vals[n],
-            geo_inst.t_ret_spm_vals[n],
-            geo_inst.t_set_spm_vals[n],
-            geo_inst.rho_km_vals[n],
-            geo_inst.phi_rl_deg_vals[n],
-            geo_inst.phi_ora_deg_vals[n],
-            geo_inst.B_deg_vals[n],
-            geo_inst.D_km_vals[n],
-            geo_inst.rho_dot_kms_vals[n],
-            geo_inst.phi_rl_dot_kms_vals[n],
-            geo_inst.F_km_vals[n],
-            geo_inst.R_imp_km_vals[n],
-            geo_inst.rx_km_vals[n],
-            geo_inst.ry_km_vals[n],
-            geo_inst.rz_km_vals[n],
-            geo_inst.vx_kms_vals[n],
-            geo_inst.vy_kms_vals[n],
-            geo_inst.vz_kms_vals[n],
-            geo_inst.elev_deg_vals[n],
-            '\r\n'))
-    f.close()
+    pds3.pds3_write_series_data(columns, format_str, out_file)
     return None
 
 
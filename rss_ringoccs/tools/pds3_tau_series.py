@@ -14,6 +14,32 @@ import time
 import sys
 from . import pds3_write_series_v2 as pds3
 
+def get_tau_series_columns(tau_inst):
+    """
+    This returns the columns of a TAU data file, in order, with the names
+    used by CSV_tools.get_tau.
+
+    Args:
+        tau_inst (class): Instance of diffraction_correction class
+
+    Outputs:
+        columns (list): List of (name, array) pairs
+    """
+    return [
+            ('rho_km_vals', tau_inst.rho_km_vals),
+            ('rho_km_pole_corr_vals', tau_inst.rho_corr_pole_km_vals),
+            ('rho_km_offsett_vals', tau_inst.rho_corr_timing_km_vals),
+            ('phi_rl_deg_vals', np.degrees(tau_inst.phi_rl_rad_vals)),
+            ('phi_ora_deg_vals', np.degrees(tau_inst.phi_rad_vals)),
+            ('p_norm_vals', tau_inst.power_vals),
+            ('raw_tau_vals', tau_inst.tau_vals),
+            ('phase_deg_vals', np.degrees(tau_inst.phase_vals)),
+            ('raw_tau_threshold_vals', tau_inst.tau_threshold_vals),
+            ('spm_vals', tau_inst.t_oet_spm_vals),
+            ('t_ret_spm_vals', tau_inst.t_ret_spm_vals),
+            ('t_set_spm_vals', tau_inst.t_set_spm_vals),
+            ('B_deg_vals', np.degrees(tau_inst.B_rad_vals))]
+
 def write_tau_series_data(tau_inst, out_file):
     """
     This writes a TAU data file.
@@ -25,30 +51,12 @@ def write_tau_series_data(tau_inst, out_file):
     """
     format_str = ('%14.6F,' + '%10.6F,' + '%10.6F,' + '%12.6F,' + '%12.6F,'
             + '%14.6E,' + '%14.6E,' + '%12.6F,' + '%14.6E,' + '%14.6F,'
-            + '%14.6F,' + '%14.6F,' + '%12.6F' + '%s')
-    npts = len(tau_inst.t_oet_spm_vals)
+            + '%14.6F,' + '%14.6F,' + '%12.6F')
+    columns = [col for name, col in get_tau_series_columns(tau_inst)]
 
     print('\tWriting TAU data to: \n\t\t' + '/'.join(out_file.split('/')[0:5]) + '/\n\t\t\t' + '/'.join(out_file.split('/')[5:]))
 
-    f = open(out_file, 'w')
-    for n in range(npts):
-        f.write(format_str % (
-            tau_inst.rho_km_vals[n],
-            tau_inst.rho_corr_pole_km_vals[n],
-            tau_inst.rho_corr_timing_km_vals[n],
-            np.degrees(tau_inst.phi_rl_rad_vals[n]),
-            np.degrees(tau_inst.phi_rad_vals[n]),
-            tau_inst.power_vals[n],
-            tau_inst.tau_vals[n],
-            np.degrees(tau_inst.phase_vals[n]),
-            tau_inst.tau_threshold_vals[n],
-            tau_inst.t_oet_spm_vals[n],
-            tau_inst.t_ret_spm_vals[n],
-            tau_inst.t_set_spm_vals[n],
-            np.degrees(tau_inst.B_rad_vals[n]),
-            '\r\n'))
-            
-    f.close()
+    pds3.pds3_write_series_data(columns, format_str, out_file)
 
 
     return None
@@ -249,6 +249,34 @@ def pds3_write_series_lbl(str_lbl, out_lbl_file):
     f.close()
 
     
+    return None
+
+def pds3_write_series_data(columns, format_str, out_file, block_rows=8192):
+    """
+    Write the rows of a series data file. Rows are formatted a block at a
+    time with one format string for the whole block, rather than one row
+    at a time, and written in large buffered blocks. Each value is
+    formatted by the same conversion as for a single row, so the file is
+    byte for byte the same.
+
+    Arguments
+        :columns (*list*): Arrays of the columns, in order, all of the
+                           same length
+        :format_str (*str*): Format of one row, without the line ending,
+                             e.g. '%14.6F,%12.6F'
+        :out_file (*str*): Path to output file
+
+    Keyword Arguments
+        :block_rows (*int*): Number of rows formatted at a time
+    """
+    row_fmt = format_str + '\r\n'
+    npts = min(len(col) for col in columns)
+    f = open(out_file, 'w', buffering=1 << 22)
+    for n in range(0, npts, block_rows):
+        block = np.column_stack([col[n:n+block_rows] for col in columns])
+        f.write((row_fmt * len(block)) % tuple(block.ravel().tolist()))
+    f.close()
+
     return None
 
 def write_history_text(f, hist_list_keys, hist_dict, hist_dict_keys):
@@ -0,0 +1,188 @@
+"""
+spice_session.py
+
+Purpose:
+    Keep track of the NAIF kernels loaded into the SPICE kernel pool so
+    that a kernel set is only furnished once per process, no matter how
+    many functions in ``occgeo`` and ``calibration`` ask for it. Also
+    provides a way to make temporary edits to kernel pool variables that
+    are always undone, even if an error is raised.
+
+Dependencies:
+    #. os
+    #. time
+    #. contextlib
+    #. spiceypy
+"""
+import os
+import time
+from contextlib import contextmanager
+import spiceypy as spice
+
+class KernelSession(object):
+    """
+    Purpose:
+        Process-wide record of the kernel set in the SPICE kernel pool.
+        ``load`` only calls ``spice.kclear`` and ``spice.furnsh`` when the
+        requested kernel set differs from the one already loaded. Callers
+        that need the kernels to stay loaded across several steps (e.g.
+        one RSR file in the pipeline) can ``acquire`` and ``release`` the
+        session; while it is held, a request for a different kernel set
+        furnishes the new kernels on top of the loaded ones rather than
+        clearing the pool.
+
+    Attributes:
+        :kernels (*tuple*): Absolute paths of the loaded kernels, in the
+            order they were furnished, or None if nothing is loaded.
+        :ref_count (*int*): Number of holders of the session.
+        :n_loads (*int*): Number of times kernels were furnished.
+        :load_time (*float*): Total time spent furnishing kernels in sec.
+
+    Example:
+        >>> from rss_ringoccs.tools.spice_session import kernel_session
+        >>> with kernel_session.hold(kernels):
+        >>>     geo_inst = Geometry(rsr_inst, 'Saturn', 'Cassini', kernels)
+        >>> print(kernel_session.info())
+    """
+    def __init__(self):
+        self.kernels = None
+        self.ref_count = 0
+        self.n_loads = 0
+        self.load_time = 0.
+
+    def __normalize(self, kernels):
+        if isinstance(kernels, str):
+            kernels = [kernels]
+        return tuple(os.path.abspath(kernel) for kernel in kernels)
+
+    def __is_loaded(self, kernels):
+        # Another module may have called spice.kclear directly
+        if (self.kernels is None) or (spice.ktotal('ALL') == 0):
+            self.kernels = None
+            return False
+        return all(kernel in self.kernels for kernel in kernels)
+
+    def load(self, kernels):
+        """
+        Purpose:
+            Make sure the kernels are loaded into the kernel pool.
+
+        Arguments:
+            :kernels (*str* or *list*): Path to NAIF kernels. If None or
+                empty, nothing is done.
+
+        Returns:
+            :load_time (*float*): Time spent furnishing kernels in this
+                call, in sec. This is 0 if the kernels were already loaded.
+        """
+        if not kernels:
+            return 0.
+
+        kernels = self.__normalize(kernels)
+        if self.__is_loaded(kernels):
+            return 0.
+
+        st = time.time()
+        if (self.ref_count > 0) and (self.kernels is not None):
+            new_kernels = [k for k in kernels if k not in self.kernels]
+            for kernel in new_kernels:
+                spice.furnsh(kernel)
+            self.kernels = self.kernels + tuple(new_kernels)
+        else:
+            spice.kclear()
+            for kernel in kernels:
+                spice.furnsh(kernel)
+            self.kernels = kernels
+        load_time = time.time() - st
+
+        self.n_loads += 1
+        self.load_time += load_time
+        return load_time
+
+    def acquire(self, kernels):
+        """
+        Purpose:
+            Load the kernels and add a holder to the session.
+
+        Arguments:
+            :kernels (*str* or *list*): Path to NAIF kernels.
+        """
+        self.load(kernels)
+        self.ref_count += 1
+
+    def release(self):
+        """
+        Purpose:
+            Remove a holder from the session. The kernels stay loaded so
+            that the next ``load`` of the same set is free.
+        """
+        if self.ref_count > 0:
+            self.ref_count -= 1
+
+    def clear(self):
+        """
+        Purpose:
+            Unload all kernels, unless the session is still held.
+        """
+        if self.ref_count > 0:
+            return
+        spice.kclear()
+        self.kernels = None
+
+    @contextmanager
+    def hold(self, kernels):
+        """
+        Purpose:
+            Context manager that acquires the session on entry and
+            releases it on exit.
+
+        Arguments:
+            :kernels (*str* or *list*): Path to NAIF kernels.
+        """
+        self.acquire(kernels)
+        try:
+            yield self
+        finally:
+            self.release()
+
+    @contextmanager
+    def pool_override(self, name, dvals):
+        """
+        Purpose:
+            Context manager that temporarily replaces a double precision
+            kernel pool variable, e.g. 'BODY699_RADII', and restores its
+            original value (or removes it, if it did not exist) on exit.
+
+        Arguments:
+            :name (*str*): Name of the kernel pool variable.
+            :dvals (*list*): Values to put in the kernel pool.
+        """
+        try:
+            original = list(spice.gdpool(name, 0, 1000))
+        except Exception:
+            original = None
+
+        spice.pdpool(name, list(dvals))
+        try:
+            yield
+        finally:
+            if original is None:
+                spice.dvpool(name)
+            else:
+                spice.pdpool(name, original)
+
+    def info(self):
+        """
+        Purpose:
+            Summary of the session for processing history dictionaries.
+
+        Returns:
+            :info (*dict*): Dictionary with keys "kernel_loads" and
+                "kernel_load_time_sec"
+        """
+        return {
+                "kernel_loads": self.n_loads,
+                "kernel_load_time_sec": round(self.load_time, 3)
+                }
+
+kernel_session = KernelSession()
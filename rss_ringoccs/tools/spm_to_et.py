@@ -5,6 +5,7 @@ Purpose:
 """
 import numpy as np
 import spiceypy as spice
+from .spice_session import kernel_session
 import sys
 import pdb
 
@@ -32,12 +33,11 @@ def spm_to_et(spm, doy, year, kernels=None):
 
 
 
-    # Leap seconds kernel
-    if kernels is None:
+    # Leap seconds kernel, unless kernels have already been loaded
+    if (kernels is None) and (kernel_session.kernels is None):
         kernels = '../../kernels/naif/CASSINI/kernels/lsk/naif0012.tls'
 
-    spice.kclear()
-    spice.furnsh(kernels)
+    kernel_session.load(kernels)
 
     hours = (spm / 3600.0).astype(int)
     remainder_spm = (spm - hours*3600.0).astype(int)
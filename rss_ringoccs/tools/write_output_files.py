@@ -11,6 +11,7 @@ write_output_files.py
     #. pds3_cal_series
     #. pds3_dlp_series
     #. pds3_tau_series
+    #. columnar
     #. time
     #. os
 
@@ -20,6 +21,11 @@ from .pds3_geo_series import write_geo_series
 from .pds3_cal_series import write_cal_series
 from .pds3_dlp_series import write_dlp_series
 from .pds3_tau_series import write_tau_series
+from .pds3_geo_series import get_geo_series_columns
+from .pds3_cal_series import get_cal_series_columns
+from .pds3_dlp_series import get_dlp_series_columns
+from .pds3_tau_series import get_tau_series_columns
+from .columnar import write_columns
 from time import strftime
 
 sys.path.append('../../')
@@ -38,10 +44,34 @@ func_typ = {'GEO': write_geo_series,
         'DLP': write_dlp_series,
         'TAU': write_tau_series}
 
+col_typ = {'GEO': get_geo_series_columns,
+        'CAL': get_cal_series_columns,
+        'DLP': get_dlp_series_columns,
+        'TAU': get_tau_series_columns}
+
+# Binary columnar copies of the .TAB files, see set_binary_output
+binary_output = {'enabled': False, 'compress': False}
+
+def set_binary_output(enabled=True, compress=False):
+    """
+    Write a binary columnar .NPZ file next to every .TAB and .LBL file,
+    with the same columns, which CSV_tools can read without parsing text
+    (see columnar.py).
+
+    Args:
+        enabled (bool):
+            Write the .NPZ files.
+        compress (bool):
+            Compress the .NPZ files. Compressed files are smaller but
+            cannot be memory-mapped when read.
+    """
+    binary_output['enabled'] = enabled
+    binary_output['compress'] = compress
+
 def write_output_files(inst):
     """
     Write output (geo, cal, dlp, tau) *.TAB and *.LBL files, depending on 
-    instance given.
+    instance given, and *.NPZ files if set_binary_output was called.
 
     Args:
         inst (instance):
@@ -148,6 +178,10 @@ def construct_output_filename(rev_info, inst, filtyp):
         outdir = outdirs[n]
         func_typ[filtyp[0:3]](rev_info, inst, title, outdir,
                 rev_info['prof_dir'])
+        if binary_output['enabled']:
+            write_columns(outdir + title.upper() + '.NPZ',
+                    col_typ[filtyp[0:3]](inst),
+                    compress=binary_output['compress'])
 
     return None
 